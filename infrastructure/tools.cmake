@@ -1,4 +1,4 @@
-# Copyright (c) 2025 Wojciech Kałuża
+# Copyright (c) 2025-2026 Wojciech Kałuża
 # SPDX-License-Identifier: MIT
 # For license details, see LICENSE file
 
@@ -10,6 +10,12 @@ macro(add_to_all_tests)
   endif()
 endmacro()
 
+macro(add_to_all_benchmarks)
+  if(TARGET all_benchmarks)
+    add_dependencies(all_benchmarks ${arg_TARGET})
+  endif()
+endmacro()
+
 macro(define_tests)
   add_test(NAME test_${arg_TARGET} COMMAND $<TARGET_FILE:${arg_TARGET}>)
   set_tests_properties(test_${arg_TARGET} PROPERTIES LABELS test)
@@ -427,6 +433,23 @@ function(new_multifile_test name)
   common_macros()
 endfunction()
 
+function(new_benchmark name)
+  set(arg_TARGET ${name})
+  set(arg_DIRECTORY test/benchmarks/${name})
+  set(arg_SOURCES main.cpp)
+  set(arg_PRIVATE_LINKS waypoint)
+
+  prepare_paths()
+
+  add_executable(${arg_TARGET})
+  target_compile_features(${arg_TARGET} PRIVATE cxx_std_23)
+
+  exclude_from_all()
+  add_to_all_benchmarks()
+  disable_exceptions_in_coverage_mode()
+  common_macros()
+endfunction()
+
 function(prepare_installation)
   add_library(waypoint::waypoint ALIAS waypoint)
   add_library(waypoint::waypoint_main ALIAS waypoint_main)
@@ -449,6 +472,7 @@ function(prepare_installation)
               assert
               coverage
               process
+              timing_database
               library_interface_headers_waypoint_impl
       EXPORT waypoint-targets
       FILE_SET interface_headers_waypoint_impl
@@ -1,13 +1,17 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace waypoint::internal
 {
@@ -22,7 +26,8 @@ public:
     Assertion,
     TestComplete,
     ShuttingDown,
-    Timeout
+    Timeout,
+    TestExited
   };
 
   Response(
@@ -37,6 +42,8 @@ public:
   bool assertion_passed;
   unsigned long long assertion_index;
   std::optional<std::string> assertion_message;
+  unsigned long long exit_status;
+  unsigned long long duration_us;
 };
 
 class Command
@@ -47,6 +54,7 @@ public:
     Invalid,
     Attention,
     RunTest,
+    RunIsolatedTest,
     End
   };
 
@@ -54,6 +62,15 @@ public:
   unsigned long long test_index;
 };
 
+[[nodiscard]]
+auto encode_response(Response const &response) -> std::vector<unsigned char>;
+[[nodiscard]]
+auto decode_response(std::vector<unsigned char> const &payload) -> Response;
+[[nodiscard]]
+auto encode_command(Command const &command) -> std::vector<unsigned char>;
+[[nodiscard]]
+auto decode_command(std::vector<unsigned char> const &payload) -> Command;
+
 class InputPipeEnd_impl;
 
 class InputPipeEnd
@@ -67,11 +84,107 @@ public:
   auto operator=(InputPipeEnd &&other) noexcept -> InputPipeEnd & = delete;
 
   void write(unsigned char const *buffer, unsigned long long count) const;
+  void write(std::vector<std::span<unsigned char const>> const &buffers) const;
 
 private:
   std::unique_ptr<InputPipeEnd_impl> impl_;
 };
 
+class StagingArea_impl;
+
+// Shared memory the child stages encoded frames in before they are sent
+// through the response pipe; the parent reads it back if the child dies
+// or keeps them staged for longer than the flush interval
+class StagingArea
+{
+public:
+  ~StagingArea();
+  explicit StagingArea(StagingArea_impl *impl);
+  StagingArea(StagingArea const &other) = delete;
+  StagingArea(StagingArea &&other) noexcept;
+  auto operator=(StagingArea const &other) -> StagingArea & = delete;
+  auto operator=(StagingArea &&other) noexcept -> StagingArea & = delete;
+
+  [[nodiscard]]
+  auto append(std::vector<unsigned char> const &frame) const -> bool;
+  [[nodiscard]]
+  auto staged() const -> std::span<unsigned char const>;
+  void clear() const;
+  // Safe to call while the child is running; returns nothing if it
+  // cleared the area meanwhile
+  [[nodiscard]]
+  auto staged_payloads() const -> std::vector<std::vector<unsigned char>>;
+  void note_test_started(unsigned long long test_index) const;
+  [[nodiscard]]
+  auto test_start_time(unsigned long long test_index) const
+    -> std::optional<std::chrono::steady_clock::time_point>;
+  [[nodiscard]]
+  auto claim_test() const -> bool;
+  [[nodiscard]]
+  auto revoke_tests(unsigned long long dispatched_count) const
+    -> unsigned long long;
+
+private:
+  std::unique_ptr<StagingArea_impl> impl_;
+};
+
+class ResponseRing_impl;
+
+// Single-producer/single-consumer byte ring in shared memory which
+// carries responses instead of the pipe; the pipe only signals exit
+class ResponseRing
+{
+public:
+  ~ResponseRing();
+  explicit ResponseRing(ResponseRing_impl *impl);
+  ResponseRing(ResponseRing const &other) = delete;
+  ResponseRing(ResponseRing &&other) noexcept;
+  auto operator=(ResponseRing const &other) -> ResponseRing & = delete;
+  auto operator=(ResponseRing &&other) noexcept -> ResponseRing & = delete;
+
+  void push(std::vector<unsigned char> const &frame) const;
+  void notify() const;
+  void note_test_started(unsigned long long test_index) const;
+  [[nodiscard]]
+  auto claim_test() const -> bool;
+
+private:
+  std::unique_ptr<ResponseRing_impl> impl_;
+};
+
+class ResponseWriter
+{
+public:
+  ~ResponseWriter() = default;
+  ResponseWriter(
+    InputPipeEnd const &pipe,
+    std::optional<StagingArea> staging_area,
+    std::optional<ResponseRing> response_ring);
+  ResponseWriter(ResponseWriter const &other) = delete;
+  ResponseWriter(ResponseWriter &&other) noexcept = delete;
+  auto operator=(ResponseWriter const &other) -> ResponseWriter & = delete;
+  auto operator=(ResponseWriter &&other) noexcept -> ResponseWriter & = delete;
+
+  void stage(Response const &response);
+  void send(Response const &response);
+  // Lets the parent time the test from when it actually started,
+  // without sending anything
+  void note_test_started(unsigned long long test_index);
+  // Must be called for each test command before running the test.
+  // Returns false if the parent revoked the test, which must then be
+  // skipped without a response.
+  [[nodiscard]]
+  auto claim_test() -> bool;
+
+private:
+  void flush(std::vector<unsigned char> const &frame);
+  void flush_staging_area(std::vector<unsigned char> const &frame);
+
+  InputPipeEnd const &pipe_;
+  std::optional<StagingArea> staging_area_;
+  std::optional<ResponseRing> response_ring_;
+};
+
 class OutputPipeEnd_impl;
 
 class OutputPipeEnd
@@ -91,20 +204,105 @@ public:
   auto operator=(OutputPipeEnd &&other) noexcept -> OutputPipeEnd & = delete;
 
   [[nodiscard]]
-  auto read(unsigned char *buffer, unsigned long long count) const
-    -> ReadResult;
+  auto read_frame(std::vector<unsigned char> &payload) const -> ReadResult;
+  [[nodiscard]]
+  auto has_buffered_frame() const -> bool;
 
 private:
   std::unique_ptr<OutputPipeEnd_impl> impl_;
 };
 
+enum class Transport : unsigned char
+{
+  Pipe,
+  SharedMemory
+};
+
+class Zygote_impl;
+
+class Zygote
+{
+public:
+  ~Zygote();
+  explicit Zygote(Zygote_impl *impl);
+  Zygote(Zygote const &other) = delete;
+  Zygote(Zygote &&other) noexcept;
+  auto operator=(Zygote const &other) -> Zygote & = delete;
+  auto operator=(Zygote &&other) noexcept -> Zygote & = delete;
+
+private:
+  std::unique_ptr<Zygote_impl> impl_;
+
+  friend class ChildProcess;
+};
+
+// Forks a process which then forks workers from the current state, so
+// they skip execve and static initialization. Returns std::nullopt if
+// other threads make forking unsafe, and in the workers themselves,
+// which is_child() identifies
+[[nodiscard]]
+auto start_zygote() noexcept -> std::optional<Zygote>;
+
+class ReadOnlyRegion_impl;
+
+// Shared memory which is filled once and then sealed, so that child
+// processes map the same pages instead of each building a copy
+class ReadOnlyRegion
+{
+public:
+  ~ReadOnlyRegion();
+  explicit ReadOnlyRegion(ReadOnlyRegion_impl *impl);
+  ReadOnlyRegion(ReadOnlyRegion const &other) = delete;
+  ReadOnlyRegion(ReadOnlyRegion &&other) noexcept;
+  auto operator=(ReadOnlyRegion const &other) -> ReadOnlyRegion & = delete;
+  auto operator=(ReadOnlyRegion &&other) noexcept
+    -> ReadOnlyRegion & = delete;
+
+  [[nodiscard]]
+  auto data() const -> unsigned char const *;
+  [[nodiscard]]
+  auto size() const -> unsigned long long;
+
+private:
+  std::unique_ptr<ReadOnlyRegion_impl> impl_;
+
+  friend class ChildProcess;
+};
+
+// fill writes all size bytes of the region before it is sealed
+[[nodiscard]]
+auto create_read_only_region(
+  unsigned long long size,
+  std::function<void(unsigned char *)> const &fill) noexcept
+  -> ReadOnlyRegion;
+
 class ChildProcess_impl;
+class ChildProcess;
+
+// The most tests a child can be dispatched, as it counts the tests it
+// claimed and the parent revoked in 32 bits each. The counts start
+// from 0 in every new child, so the parent replaces a child before it
+// would be dispatched more.
+constexpr unsigned long long MAX_TESTS_PER_CHILD = 0xFFFF'FFFF;
+
+// Returns the indices of children with a response to read, or no
+// indices once the deadline, if any, has passed
+[[nodiscard]]
+auto wait_for_readable(
+  std::vector<ChildProcess const *> const &children,
+  std::optional<std::chrono::steady_clock::time_point> deadline)
+  -> std::vector<unsigned long long>;
 
 class ChildProcess
 {
 public:
   ~ChildProcess();
-  ChildProcess();
+  // The child maps shared_data, if any, which
+  // get_read_only_region_from_env() then returns in it
+  ChildProcess(
+    Transport transport,
+    Zygote const *zygote,
+    ReadOnlyRegion const *shared_data);
   ChildProcess(ChildProcess const &other) = delete;
   ChildProcess(ChildProcess &&other) noexcept = delete;
   auto operator=(ChildProcess const &other) -> ChildProcess & = delete;
@@ -113,18 +311,57 @@ public:
   [[nodiscard]]
   auto command_write_pipe() const -> InputPipeEnd const &;
   [[nodiscard]]
-  auto response_read_pipe() const -> OutputPipeEnd const &;
+  auto read_response_frame(std::vector<unsigned char> &payload) const
+    -> OutputPipeEnd::ReadResult;
+  [[nodiscard]]
+  auto has_buffered_response() const -> bool;
+  [[nodiscard]]
+  auto staged_payloads() const -> std::vector<std::vector<unsigned char>>;
+  // Returns std::nullopt unless test_index is the test the child
+  // started last
+  [[nodiscard]]
+  auto test_start_time(unsigned long long test_index) const
+    -> std::optional<std::chrono::steady_clock::time_point>;
+  // Revokes every test dispatched to the child, out of
+  // dispatched_count so far, which it has not claimed yet. Returns the
+  // number of tests it claimed, or skipped after earlier revocations.
+  [[nodiscard]]
+  auto revoke_tests(unsigned long long dispatched_count) const
+    -> unsigned long long;
 
+  // The child's responses are then closed like after a crash
+  void kill() const;
   [[nodiscard]]
   auto wait() const -> unsigned long long;
 
 private:
-  std::unique_ptr<ChildProcess_impl const> impl_;
+  std::unique_ptr<ChildProcess_impl> impl_;
+
+  friend auto wait_for_readable(
+    std::vector<ChildProcess const *> const &children,
+    std::optional<std::chrono::steady_clock::time_point> deadline)
+    -> std::vector<unsigned long long>;
 };
 
+// Runs f in a forked copy of the calling process, which must have no
+// other threads, and returns its exit status as ChildProcess::wait does.
+// Returns std::nullopt if the copy was killed for running longer than
+// a non-zero timeout_ms.
+[[nodiscard]]
+auto run_in_forked_process(
+  std::function<void()> const &f,
+  unsigned long long timeout_ms) -> std::optional<unsigned long long>;
+
 [[nodiscard]]
 auto get_pipes_from_env() noexcept -> std::pair<OutputPipeEnd, InputPipeEnd>;
 [[nodiscard]]
+auto get_staging_area_from_env() noexcept -> std::optional<StagingArea>;
+[[nodiscard]]
+auto get_response_ring_from_env() noexcept -> std::optional<ResponseRing>;
+[[nodiscard]]
+auto get_read_only_region_from_env() noexcept
+  -> std::optional<ReadOnlyRegion>;
+[[nodiscard]]
 auto is_child() -> bool;
 
 } // namespace waypoint::internal
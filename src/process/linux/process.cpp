@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -9,12 +9,23 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <format>
+#include <functional>
+#include <fstream>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -22,10 +33,24 @@
 #include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
 // NOLINTNEXTLINE(modernize-deprecated-headers)
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <linux/futex.h>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
 #include <sys/wait.h>
 
 namespace
@@ -39,6 +64,42 @@ char const *const WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME =
   "WAYPOINT_INTERNAL_COMMAND_SOURCE_g0j3YuHH";
 char const *const WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME =
   "WAYPOINT_INTERNAL_RESPONSE_SINK_suwAYZVy";
+char const *const WAYPOINT_INTERNAL_STAGING_AREA_ENV_NAME =
+  "WAYPOINT_INTERNAL_STAGING_AREA_Xq4mTz8c";
+
+char const *const WAYPOINT_INTERNAL_RESPONSE_RING_ENV_NAME =
+  "WAYPOINT_INTERNAL_RESPONSE_RING_3nVb7KpQ";
+char const *const WAYPOINT_INTERNAL_RESPONSE_RING_EVENT_ENV_NAME =
+  "WAYPOINT_INTERNAL_RESPONSE_RING_EVENT_Lw2cR9dE";
+char const *const WAYPOINT_INTERNAL_SHARED_DATA_ENV_NAME =
+  "WAYPOINT_INTERNAL_SHARED_DATA_Hd5sWq2N";
+
+constexpr unsigned long long STAGING_AREA_SIZE = 1'048'576;
+// The first cache line holds the number of staged bytes, the test
+// start stamp, the claim word and the number of times it was cleared
+constexpr unsigned long long STAGING_AREA_HEADER_SIZE = 64;
+constexpr unsigned long long STAGING_AREA_TEST_START_OFFSET = 8;
+constexpr unsigned long long STAGING_AREA_CLAIM_OFFSET = 24;
+constexpr unsigned long long STAGING_AREA_GENERATION_OFFSET = 32;
+
+constexpr unsigned long long RESPONSE_RING_CAPACITY = 4'194'304;
+// Consumer and producer counters live on separate cache lines
+constexpr unsigned long long RESPONSE_RING_HEADER_SIZE = 4'096;
+constexpr unsigned long long RESPONSE_RING_NOTIFY_THRESHOLD = 262'144;
+constexpr unsigned long long RESPONSE_RING_HEAD_OFFSET = 0;
+constexpr unsigned long long RESPONSE_RING_SPACE_FUTEX_OFFSET = 8;
+constexpr unsigned long long RESPONSE_RING_PRODUCER_WAITING_OFFSET = 12;
+constexpr unsigned long long RESPONSE_RING_TAIL_OFFSET = 64;
+constexpr unsigned long long RESPONSE_RING_CONSUMER_WAITING_OFFSET = 72;
+constexpr unsigned long long RESPONSE_RING_TEST_START_OFFSET = 128;
+constexpr unsigned long long RESPONSE_RING_CLAIM_OFFSET = 144;
+constexpr auto RESPONSE_RING_PARENT_CHECK_INTERVAL =
+  std::chrono::milliseconds{100};
+
+constexpr unsigned long long ZYGOTE_MAX_FDS = 8;
+constexpr unsigned long long ZYGOTE_MAX_MESSAGE_SIZE = 4'096;
+constexpr unsigned char ZYGOTE_SPAWN_REQUEST = 0;
+constexpr unsigned char ZYGOTE_WAIT_REQUEST = 1;
 
 auto get_env(std::string const &var_name) -> std::optional<std::string>
 {
@@ -51,6 +112,11 @@ auto get_env(std::string const &var_name) -> std::optional<std::string>
   return {var_value};
 }
 
+void set_env(std::string const &var_name, std::string const &value)
+{
+  ::setenv(var_name.c_str(), value.c_str(), 1);
+}
+
 void unset_env(std::string const &var_name)
 {
   ::unsetenv(var_name.c_str());
@@ -94,6 +160,170 @@ auto str2int(std::string_view const str, unsigned char const base) -> int
   return result;
 }
 
+void append_varint(std::vector<unsigned char> &buffer, unsigned long long value)
+{
+  constexpr unsigned char continuation = 0x80;
+  constexpr unsigned char payload_mask = 0x7f;
+  constexpr unsigned char payload_bits = 7;
+
+  while(value >= continuation)
+  {
+    buffer.push_back(
+      static_cast<unsigned char>(value & payload_mask) | continuation);
+    value >>= payload_bits;
+  }
+
+  buffer.push_back(static_cast<unsigned char>(value));
+}
+
+auto parse_varint(
+  std::vector<unsigned char> const &buffer,
+  unsigned long long &position) -> std::optional<unsigned long long>
+{
+  constexpr unsigned char continuation = 0x80;
+  constexpr unsigned char payload_mask = 0x7f;
+  constexpr unsigned char payload_bits = 7;
+
+  unsigned long long value = 0;
+  unsigned shift = 0;
+  for(auto i = position; i < buffer.size(); ++i)
+  {
+    value |= static_cast<unsigned long long>(buffer[i] & payload_mask) << shift;
+    shift += payload_bits;
+
+    if((buffer[i] & continuation) == 0)
+    {
+      position = i + 1;
+
+      return value;
+    }
+  }
+
+  return std::nullopt;
+}
+
+auto frame(std::vector<unsigned char> const &payload)
+  -> std::vector<unsigned char>
+{
+  std::vector<unsigned char> output;
+  output.reserve(payload.size() + sizeof(unsigned long long));
+
+  append_varint(output, payload.size());
+  output.insert(output.end(), payload.begin(), payload.end());
+
+  return output;
+}
+
+// Accumulates raw bytes and hands them out one complete frame at a time
+class FrameBuffer
+{
+public:
+  FrameBuffer()
+    : begin_{0}
+  {
+  }
+
+  // Returns the offset and size of the payload of the first complete
+  // frame in the buffer
+  [[nodiscard]]
+  auto next_frame() const
+    -> std::optional<std::pair<unsigned long long, unsigned long long>>
+  {
+    auto position = this->begin_;
+    auto const maybe_size = parse_varint(this->buffer_, position);
+    if(
+      !maybe_size.has_value() ||
+      this->buffer_.size() - position < maybe_size.value())
+    {
+      return std::nullopt;
+    }
+
+    return {{position, maybe_size.value()}};
+  }
+
+  auto take_frame(std::vector<unsigned char> &payload) -> bool
+  {
+    auto const maybe_frame = this->next_frame();
+    if(!maybe_frame.has_value())
+    {
+      return false;
+    }
+
+    auto const [position, size] = maybe_frame.value();
+    auto const *const payload_begin = this->buffer_.data() + position;
+    payload.assign(payload_begin, payload_begin + size);
+    this->begin_ = position + size;
+
+    return true;
+  }
+
+  // fill receives room for max_count bytes and returns how many it
+  // produced, or a negative number on failure
+  template<typename Fill>
+  auto fill(unsigned long long const max_count, Fill const &fill)
+  {
+    this->buffer_.erase(
+      this->buffer_.begin(),
+      this->buffer_.begin() + static_cast<std::ptrdiff_t>(this->begin_));
+    this->begin_ = 0;
+
+    auto const old_size = this->buffer_.size();
+    this->buffer_.resize(old_size + max_count);
+
+    auto const filled = fill(this->buffer_.data() + old_size, max_count);
+    this->buffer_.resize(
+      old_size +
+      static_cast<unsigned long long>(std::max<long long>(0, filled)));
+
+    return filled;
+  }
+
+private:
+  std::vector<unsigned char> buffer_;
+  unsigned long long begin_;
+};
+
+class SigpipeBlock
+{
+public:
+  ~SigpipeBlock()
+  {
+    if(this->raised_ && sigismember(&this->previous_mask_, SIGPIPE) == 0)
+    {
+      // Consume the SIGPIPE raised by the failed write before unblocking
+      ::timespec const no_wait{};
+      ::sigtimedwait(&this->sigpipe_, nullptr, &no_wait);
+    }
+
+    ::pthread_sigmask(SIG_SETMASK, &this->previous_mask_, nullptr);
+  }
+
+  SigpipeBlock()
+    : sigpipe_{},
+      previous_mask_{},
+      raised_{false}
+  {
+    sigemptyset(&this->sigpipe_);
+    sigaddset(&this->sigpipe_, SIGPIPE);
+    ::pthread_sigmask(SIG_BLOCK, &this->sigpipe_, &this->previous_mask_);
+  }
+
+  SigpipeBlock(SigpipeBlock const &other) = delete;
+  SigpipeBlock(SigpipeBlock &&other) noexcept = delete;
+  auto operator=(SigpipeBlock const &other) -> SigpipeBlock & = delete;
+  auto operator=(SigpipeBlock &&other) noexcept -> SigpipeBlock & = delete;
+
+  void mark_as_raised()
+  {
+    this->raised_ = true;
+  }
+
+private:
+  ::sigset_t sigpipe_;
+  ::sigset_t previous_mask_;
+  bool raised_;
+};
+
 } // namespace
 
 namespace waypoint::internal
@@ -107,8 +337,9 @@ public:
     ::close(this->pipe_);
   }
 
-  explicit InputPipeEnd_impl(int const pipe)
-    : pipe_{pipe}
+  explicit InputPipeEnd_impl(int const pipe, bool const is_parent_side)
+    : pipe_{pipe},
+      is_parent_side_{is_parent_side}
   {
   }
 
@@ -126,8 +357,15 @@ public:
     return this->pipe_;
   }
 
+  [[nodiscard]]
+  auto is_parent_side() const -> bool
+  {
+    return this->is_parent_side_;
+  }
+
 private:
   int pipe_;
+  bool is_parent_side_;
 };
 
 InputPipeEnd::~InputPipeEnd() = default;
@@ -143,16 +381,69 @@ void InputPipeEnd::write(
   unsigned char const *const buffer,
   unsigned long long const count) const
 {
-  unsigned left_to_transfer = count;
-  unsigned transferred = 0;
+  this->write({std::span{buffer, count}});
+}
+
+void InputPipeEnd::write(
+  std::vector<std::span<unsigned char const>> const &buffers) const
+{
+  // The parent may write ahead to a child that has already died; the
+  // resulting EPIPE is ignored here and the crash is detected on read
+  std::optional<SigpipeBlock> sigpipe_block;
+  if(this->impl_->is_parent_side())
+  {
+    sigpipe_block.emplace();
+  }
+
+  std::vector<::iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for(auto const &buffer : buffers)
+  {
+    if(!buffer.empty())
+    {
+      iovecs.push_back(::iovec{
+        const_cast<unsigned char *>(buffer.data()),
+        buffer.size()});
+    }
+  }
 
-  while(left_to_transfer > 0)
+  auto remaining = std::span{iovecs};
+  while(!remaining.empty())
   {
-    auto const transferred_this_time =
-      ::write(this->impl_->raw_pipe(), buffer + transferred, left_to_transfer);
+    auto const transferred =
+      ::writev(this->impl_->raw_pipe(), remaining.data(), remaining.size());
+
+    if(transferred < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+
+      waypoint::internal::assert(errno == EPIPE, "Unexpected write error");
+      if(sigpipe_block.has_value())
+      {
+        sigpipe_block->mark_as_raised();
+      }
+
+      return;
+    }
+
+    // Skip past whatever was written, possibly part of a buffer
+    auto left_to_skip = static_cast<unsigned long long>(transferred);
+    while(!remaining.empty() && left_to_skip >= remaining.front().iov_len)
+    {
+      left_to_skip -= remaining.front().iov_len;
+      remaining = remaining.subspan(1);
+    }
 
-    transferred += transferred_this_time;
-    left_to_transfer -= transferred_this_time;
+    if(!remaining.empty())
+    {
+      remaining.front().iov_base =
+        static_cast<unsigned char *>(remaining.front().iov_base) +
+        left_to_skip;
+      remaining.front().iov_len -= left_to_skip;
+    }
   }
 }
 
@@ -183,8 +474,37 @@ public:
     return this->pipe_;
   }
 
+  [[nodiscard]]
+  auto frame_buffer() -> FrameBuffer &
+  {
+    return this->frame_buffer_;
+  }
+
+  auto fill_buffer() -> bool
+  {
+    constexpr unsigned long long chunk_size = 65'536;
+
+    auto const transferred = this->frame_buffer_.fill(
+      chunk_size,
+      [this](unsigned char *const buffer, unsigned long long const count)
+      {
+        while(true)
+        {
+          auto const transferred = ::read(this->pipe_, buffer, count);
+          if(transferred >= 0 || errno != EINTR)
+          {
+            return transferred;
+          }
+        }
+      });
+
+    // Zero bytes read - the peer crashed or exited
+    return transferred > 0;
+  }
+
 private:
   int pipe_;
+  FrameBuffer frame_buffer_;
 };
 
 OutputPipeEnd::~OutputPipeEnd() = default;
@@ -194,210 +514,1371 @@ OutputPipeEnd::OutputPipeEnd(OutputPipeEnd_impl *const impl)
 {
 }
 
-auto OutputPipeEnd::read(
-  unsigned char *const buffer,
-  unsigned long long const count) const -> OutputPipeEnd::ReadResult
+auto OutputPipeEnd::read_frame(std::vector<unsigned char> &payload) const
+  -> OutputPipeEnd::ReadResult
 {
-  unsigned left_to_transfer = count;
-  unsigned transferred = 0;
-
-  while(left_to_transfer > 0)
+  while(!this->impl_->frame_buffer().take_frame(payload))
   {
-    auto const transferred_this_time =
-      ::read(this->impl_->raw_pipe(), buffer + transferred, left_to_transfer);
-
-    if(transferred_this_time == 0)
+    if(!this->impl_->fill_buffer())
     {
-      // The other end of the pipe is closed - peer crashed or exited
       return OutputPipeEnd::ReadResult::PipeClosed;
     }
-
-    transferred += transferred_this_time;
-    left_to_transfer -= transferred_this_time;
   }
 
   return OutputPipeEnd::ReadResult::Success;
 }
 
-OutputPipeEnd::OutputPipeEnd(OutputPipeEnd &&other) noexcept = default;
-
-auto get_pipes_from_env() noexcept -> std::pair<OutputPipeEnd, InputPipeEnd>
+auto OutputPipeEnd::has_buffered_frame() const -> bool
 {
-  auto const maybe_command_read_pipe =
-    get_env(WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME);
-  auto const maybe_response_write_pipe =
-    get_env(WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME);
-
-  unset_env(WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME);
-  unset_env(WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME);
-
-  auto const raw_command_read_pipe =
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    str2int(maybe_command_read_pipe.value(), 10);
-  auto const raw_response_write_pipe =
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    str2int(maybe_response_write_pipe.value(), 10);
+  return this->impl_->frame_buffer().next_frame().has_value();
+}
 
-  auto *command_read_pipe = new OutputPipeEnd_impl{raw_command_read_pipe};
-  auto *response_write_pipe = new InputPipeEnd_impl{raw_response_write_pipe};
+OutputPipeEnd::OutputPipeEnd(OutputPipeEnd &&other) noexcept = default;
 
-  return {OutputPipeEnd{command_read_pipe}, InputPipeEnd{response_write_pipe}};
+// A test start stamp holds the index of the test the child started
+// last, plus one so that zero means none, followed by the time it
+// started. The parent times tests from it rather than from dispatch.
+void store_test_start(
+  unsigned char *const stamp,
+  unsigned long long const test_index)
+{
+  auto const now = std::chrono::steady_clock::now().time_since_epoch();
+
+  std::atomic_ref{*reinterpret_cast<long long *>(stamp + 8)}.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(),
+    std::memory_order_relaxed);
+  std::atomic_ref{*reinterpret_cast<unsigned long long *>(stamp)}.store(
+    test_index + 1,
+    std::memory_order_release);
 }
 
-auto is_child() -> bool
+auto load_test_start(
+  unsigned char *const stamp,
+  unsigned long long const test_index)
+  -> std::optional<std::chrono::steady_clock::time_point>
 {
-  auto const maybe_value = get_env(WAYPOINT_INTERNAL_RUNNER_ENV_NAME);
-  if(!maybe_value.has_value())
+  auto const started_test =
+    std::atomic_ref{*reinterpret_cast<unsigned long long *>(stamp)}.load(
+      std::memory_order_acquire);
+  if(started_test != test_index + 1)
   {
-    return false;
+    return std::nullopt;
   }
 
-  unset_env(WAYPOINT_INTERNAL_RUNNER_ENV_NAME);
+  auto const started_at =
+    std::atomic_ref{*reinterpret_cast<long long *>(stamp + 8)}.load(
+      std::memory_order_relaxed);
 
-  return maybe_value.value() == WAYPOINT_INTERNAL_RUNNER_ENV_VALUE;
+  return std::chrono::steady_clock::time_point{
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::nanoseconds{started_at})};
 }
 
-Response::Response(
-  Code const code_,
-  unsigned long long const test_id_,
-  bool const assertion_passed_,
-  unsigned long long const assertion_index_,
-  std::optional<std::string> assertion_message_)
-  : code{code_},
-    test_id{test_id_},
-    assertion_passed{assertion_passed_},
-    assertion_index{assertion_index_},
-    assertion_message{std::move(assertion_message_)}
+// The claim word packs the number of tests the child has claimed or
+// skipped in its low half, and the number of tests, counted from the
+// first one dispatched, that the parent revoked in its high half.
+// A single compare-and-swap decides which side gets each test. Neither
+// half wraps, as no child is dispatched more than MAX_TESTS_PER_CHILD.
+auto claim_word(unsigned char *const word)
+  -> std::atomic_ref<unsigned long long>
 {
+  return std::atomic_ref{*reinterpret_cast<unsigned long long *>(word)};
 }
 
-} // namespace waypoint::internal
-
-namespace
-{
+constexpr unsigned long long CLAIM_WORD_HALF_BITS = 32;
+constexpr unsigned long long CLAIM_WORD_LOW_MASK = 0xFFFF'FFFF;
+static_assert(
+  waypoint::internal::MAX_TESTS_PER_CHILD <= CLAIM_WORD_LOW_MASK,
+  "Claim counts must fit their half of the claim word");
 
-auto resolve_path(std::string const &input) noexcept -> std::string
+auto claim_test(unsigned char *const word) -> bool
 {
-  std::vector<char> dest;
-  constexpr unsigned long long bufsize = 4'096;
-  dest.resize(bufsize);
-  std::ranges::fill(dest, 0);
+  auto const ref = claim_word(word);
 
-  [[maybe_unused]]
-  char const *const ret = ::realpath(input.c_str(), dest.data());
-
-  return {dest.data()};
+  auto expected = ref.load(std::memory_order_acquire);
+  while(true)
+  {
+    auto const consumed = expected & CLAIM_WORD_LOW_MASK;
+    auto const revoked = expected >> CLAIM_WORD_HALF_BITS;
+    auto const desired = (revoked << CLAIM_WORD_HALF_BITS) | (consumed + 1);
+    if(ref.compare_exchange_weak(
+         expected,
+         desired,
+         std::memory_order_acq_rel,
+         std::memory_order_acquire))
+    {
+      return consumed >= revoked;
+    }
+  }
 }
 
-auto get_path_to_current_executable() noexcept -> std::string
+auto revoke_tests(
+  unsigned char *const word,
+  unsigned long long const dispatched_count) -> unsigned long long
 {
-  std::vector<char> dest;
-  constexpr unsigned long long bufsize = 4'096;
-
-  dest.resize(bufsize);
-  std::ranges::fill(dest, 0);
-
-  [[maybe_unused]]
-  auto const ret = ::readlink("/proc/self/exe", dest.data(), bufsize);
-
-  std::string const path{dest.data()};
+  auto const ref = claim_word(word);
 
-  return resolve_path(path);
+  auto expected = ref.load(std::memory_order_acquire);
+  while(true)
+  {
+    auto const consumed = expected & CLAIM_WORD_LOW_MASK;
+    auto const desired = (dispatched_count << CLAIM_WORD_HALF_BITS) | consumed;
+    if(ref.compare_exchange_weak(
+         expected,
+         desired,
+         std::memory_order_acq_rel,
+         std::memory_order_acquire))
+    {
+      return consumed;
+    }
+  }
 }
 
-auto create_child_process(
-  std::array<int, 2> const &pipe_command,
-  std::array<int, 2> const &pipe_response) noexcept -> std::tuple<int, int, int>
+class StagingArea_impl
 {
-  auto const fork_ret = ::fork();
-  if(fork_ret > 0)
+public:
+  ~StagingArea_impl()
   {
-    auto const child_pid = fork_ret;
-
-    ::close(pipe_command[0]);
-    ::close(pipe_response[1]);
+    ::munmap(this->memory_, STAGING_AREA_SIZE);
+    ::close(this->fd_);
+  }
 
-    return {child_pid, pipe_command[1], pipe_response[0]};
+  explicit StagingArea_impl(int const fd)
+    : fd_{fd},
+      memory_{static_cast<unsigned char *>(::mmap(
+        nullptr,
+        STAGING_AREA_SIZE,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0))}
+  {
+    waypoint::internal::assert(
+      this->memory_ != MAP_FAILED,
+      "Failed to map the staging area");
   }
 
-  ::close(pipe_command[1]);
-  ::close(pipe_response[0]);
+  StagingArea_impl() = delete;
+  StagingArea_impl(StagingArea_impl const &other) = delete;
+  StagingArea_impl(StagingArea_impl &&other) noexcept = delete;
+  auto operator=(StagingArea_impl const &other) -> StagingArea_impl & = delete;
+  auto operator=(StagingArea_impl &&other) noexcept
+    -> StagingArea_impl & = delete;
 
-  auto const path_to_exe = get_path_to_current_executable();
+  [[nodiscard]]
+  auto raw_fd() const -> int
+  {
+    return this->fd_;
+  }
 
-  std::array<char const *, 2> const execve_argv = {
-    path_to_exe.c_str(),
-    nullptr};
+  [[nodiscard]]
+  auto staged_size() const -> std::atomic_ref<unsigned long long>
+  {
+    return std::atomic_ref{
+      *reinterpret_cast<unsigned long long *>(this->memory_)};
+  }
 
-  auto const runner_mode_env = std::format(
-    "{}={}",
-    WAYPOINT_INTERNAL_RUNNER_ENV_NAME,
-    WAYPOINT_INTERNAL_RUNNER_ENV_VALUE);
-  auto const command_source_env = std::format(
-    "{}={}",
-    WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME,
-    int2str(pipe_command[0], 10));
-  auto const response_sink_env = std::format(
-    "{}={}",
-    WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME,
-    int2str(pipe_response[1], 10));
+  [[nodiscard]]
+  auto generation() const -> std::atomic_ref<unsigned long long>
+  {
+    return std::atomic_ref{*reinterpret_cast<unsigned long long *>(
+      this->memory_ + STAGING_AREA_GENERATION_OFFSET)};
+  }
 
-  std::vector execve_envp = {
-    runner_mode_env.c_str(),
-    command_source_env.c_str(),
-    response_sink_env.c_str()};
+  [[nodiscard]]
+  auto test_start_stamp() const -> unsigned char *
+  {
+    return this->memory_ + STAGING_AREA_TEST_START_OFFSET;
+  }
 
-  // ::environ is declared in <unistd.h>
-  for(auto const *e = ::environ; *e != nullptr; ++e)
+  [[nodiscard]]
+  auto claim_word() const -> unsigned char *
   {
-    execve_envp.push_back(*e);
+    return this->memory_ + STAGING_AREA_CLAIM_OFFSET;
   }
 
-  execve_envp.push_back(nullptr);
+  [[nodiscard]]
+  auto data() const -> unsigned char *
+  {
+    return this->memory_ + STAGING_AREA_HEADER_SIZE;
+  }
 
-  waypoint::coverage::gcov_dump();
+private:
+  int fd_;
+  unsigned char *memory_;
+};
 
-  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
-  ::execve(
-    path_to_exe.c_str(),
-    const_cast<char *const *>(execve_argv.data()),
-    const_cast<char *const *>(execve_envp.data()));
-  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
+StagingArea::~StagingArea() = default;
 
-  std::unreachable();
+StagingArea::StagingArea(StagingArea_impl *const impl)
+  : impl_{std::unique_ptr<StagingArea_impl>{impl}}
+{
 }
 
-auto create_child_process_with_pipes() noexcept -> std::tuple<int, int, int>
+StagingArea::StagingArea(StagingArea &&other) noexcept = default;
+
+auto StagingArea::append(std::vector<unsigned char> const &frame) const
+  -> bool
 {
-  std::array<int, 2> pipe_command{};
-  std::array<int, 2> pipe_response{};
+  constexpr auto capacity = STAGING_AREA_SIZE - STAGING_AREA_HEADER_SIZE;
 
-  [[maybe_unused]]
-  auto const ret1 = ::pipe(pipe_command.data());
-  [[maybe_unused]]
-  auto const ret2 = ::pipe(pipe_response.data());
+  auto const staged_size = this->impl_->staged_size().load();
+  if(capacity - staged_size < frame.size())
+  {
+    return false;
+  }
+
+  std::ranges::copy(frame, this->impl_->data() + staged_size);
 
-  return create_child_process(pipe_command, pipe_response);
+  // Only whole frames become visible to the parent
+  this->impl_->staged_size().store(
+    staged_size + frame.size(),
+    std::memory_order_release);
+
+  return true;
 }
 
-auto wait_for_child_process_end(int const child_pid) -> unsigned long long
+auto StagingArea::staged() const -> std::span<unsigned char const>
+{
+  return {this->impl_->data(), this->impl_->staged_size().load()};
+}
+
+void StagingArea::clear() const
+{
+  // Frames staged afterwards overwrite the old ones, which a parent
+  // reading concurrently detects by the generation changing
+  this->impl_->generation().fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->impl_->staged_size().store(0, std::memory_order_release);
+}
+
+void StagingArea::note_test_started(unsigned long long const test_index) const
+{
+  store_test_start(this->impl_->test_start_stamp(), test_index);
+}
+
+auto StagingArea::test_start_time(unsigned long long const test_index) const
+  -> std::optional<std::chrono::steady_clock::time_point>
+{
+  return load_test_start(this->impl_->test_start_stamp(), test_index);
+}
+
+auto StagingArea::claim_test() const -> bool
+{
+  return waypoint::internal::claim_test(this->impl_->claim_word());
+}
+
+auto StagingArea::revoke_tests(unsigned long long const dispatched_count) const
+  -> unsigned long long
+{
+  return waypoint::internal::revoke_tests(
+    this->impl_->claim_word(),
+    dispatched_count);
+}
+
+auto StagingArea::staged_payloads() const
+  -> std::vector<std::vector<unsigned char>>
+{
+  auto const generation =
+    this->impl_->generation().load(std::memory_order_acquire);
+  auto const staged = this->staged();
+  std::vector<unsigned char> const buffer{staged.begin(), staged.end()};
+
+  // The child cleared the area while it was being copied, so its
+  // frames were flushed through the pipe instead
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if(
+    this->impl_->generation().load(std::memory_order_relaxed) != generation)
+  {
+    return {};
+  }
+
+  std::vector<std::vector<unsigned char>> payloads;
+  unsigned long long position = 0;
+  while(position < buffer.size())
+  {
+    auto const maybe_size = parse_varint(buffer, position);
+    if(
+      !maybe_size.has_value() ||
+      buffer.size() - position < maybe_size.value())
+    {
+      break;
+    }
+
+    auto const *const payload_begin = buffer.data() + position;
+    payloads.emplace_back(payload_begin, payload_begin + maybe_size.value());
+    position += maybe_size.value();
+  }
+
+  return payloads;
+}
+
+class ResponseRing_impl
+{
+public:
+  ~ResponseRing_impl()
+  {
+    ::munmap(this->memory_, RESPONSE_RING_HEADER_SIZE + RESPONSE_RING_CAPACITY);
+    ::close(this->event_fd_);
+    ::close(this->fd_);
+  }
+
+  ResponseRing_impl(int const fd, int const event_fd)
+    : fd_{fd},
+      event_fd_{event_fd},
+      memory_{static_cast<unsigned char *>(::mmap(
+        nullptr,
+        RESPONSE_RING_HEADER_SIZE + RESPONSE_RING_CAPACITY,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0))},
+      owner_pid_{::getpid()},
+      parent_pid_{::getppid()},
+      unnotified_bytes_{0}
+  {
+    waypoint::internal::assert(
+      this->memory_ != MAP_FAILED,
+      "Failed to map the response ring");
+  }
+
+  ResponseRing_impl() = delete;
+  ResponseRing_impl(ResponseRing_impl const &other) = delete;
+  ResponseRing_impl(ResponseRing_impl &&other) noexcept = delete;
+  auto operator=(ResponseRing_impl const &other)
+    -> ResponseRing_impl & = delete;
+  auto operator=(ResponseRing_impl &&other) noexcept
+    -> ResponseRing_impl & = delete;
+
+  [[nodiscard]]
+  auto raw_fd() const -> int
+  {
+    return this->fd_;
+  }
+
+  [[nodiscard]]
+  auto raw_event_fd() const -> int
+  {
+    return this->event_fd_;
+  }
+
+  // Producer side, runs in the child. Frames are visible to the parent
+  // as soon as they are pushed, even if the child dies before notifying
+  void push(std::vector<unsigned char> const &frame)
+  {
+    unsigned long long written = 0;
+    while(written < frame.size())
+    {
+      auto const tail = this->tail().load(std::memory_order_relaxed);
+      auto const head = this->head().load(std::memory_order_acquire);
+      auto const free_space = RESPONSE_RING_CAPACITY - (tail - head);
+      if(free_space == 0)
+      {
+        this->wait_for_space(head);
+
+        continue;
+      }
+
+      auto const count = std::min(free_space, frame.size() - written);
+      auto const offset = tail % RESPONSE_RING_CAPACITY;
+      auto const first_part = std::min(count, RESPONSE_RING_CAPACITY - offset);
+      std::ranges::copy_n(
+        frame.data() + written,
+        static_cast<std::ptrdiff_t>(first_part),
+        this->data() + offset);
+      std::ranges::copy_n(
+        frame.data() + written + first_part,
+        static_cast<std::ptrdiff_t>(count - first_part),
+        this->data());
+
+      this->tail().store(tail + count, std::memory_order_seq_cst);
+      written += count;
+      this->unnotified_bytes_ += count;
+    }
+
+    if(this->unnotified_bytes_ >= RESPONSE_RING_NOTIFY_THRESHOLD)
+    {
+      this->notify();
+    }
+  }
+
+  void notify()
+  {
+    this->unnotified_bytes_ = 0;
+
+    // Only pay for the syscall when the parent is about to sleep
+    if(this->consumer_waiting().exchange(0, std::memory_order_seq_cst) != 0)
+    {
+      [[maybe_unused]]
+      auto const ret = ::eventfd_write(this->event_fd_, 1);
+    }
+  }
+
+  // Consumer side, runs in the parent
+  [[nodiscard]]
+  auto pull(FrameBuffer &frame_buffer) const -> bool
+  {
+    auto const head = this->head().load(std::memory_order_relaxed);
+    auto const tail = this->tail().load(std::memory_order_acquire);
+    if(head == tail)
+    {
+      return false;
+    }
+
+    frame_buffer.fill(
+      tail - head,
+      [this, head](unsigned char *const buffer, unsigned long long const count)
+      {
+        auto const offset = head % RESPONSE_RING_CAPACITY;
+        auto const first_part =
+          std::min(count, RESPONSE_RING_CAPACITY - offset);
+        std::ranges::copy_n(
+          this->data() + offset,
+          static_cast<std::ptrdiff_t>(first_part),
+          buffer);
+        std::ranges::copy_n(
+          this->data(),
+          static_cast<std::ptrdiff_t>(count - first_part),
+          buffer + first_part);
+
+        return static_cast<long long>(count);
+      });
+
+    this->head().store(tail, std::memory_order_seq_cst);
+    this->space_futex().fetch_add(1, std::memory_order_seq_cst);
+    if(this->producer_waiting().exchange(0, std::memory_order_seq_cst) != 0)
+    {
+      ::syscall(
+        SYS_futex,
+        this->space_futex_address(),
+        FUTEX_WAKE,
+        1,
+        nullptr,
+        nullptr,
+        0);
+    }
+
+    return true;
+  }
+
+  [[nodiscard]]
+  auto is_empty() const -> bool
+  {
+    return this->head().load(std::memory_order_seq_cst) ==
+      this->tail().load(std::memory_order_seq_cst);
+  }
+
+  // Returns true if data arrived in the meantime and there is no need
+  // to wait for the event
+  [[nodiscard]]
+  auto prepare_to_wait() const -> bool
+  {
+    this->consumer_waiting().store(1, std::memory_order_seq_cst);
+
+    return !this->is_empty();
+  }
+
+  void finish_waiting() const
+  {
+    this->consumer_waiting().store(0, std::memory_order_seq_cst);
+
+    eventfd_t value = 0;
+    [[maybe_unused]]
+    auto const ret = ::eventfd_read(this->event_fd_, &value);
+  }
+
+  void note_test_started(unsigned long long const test_index) const
+  {
+    store_test_start(
+      this->memory_ + RESPONSE_RING_TEST_START_OFFSET,
+      test_index);
+  }
+
+  [[nodiscard]]
+  auto test_start_time(unsigned long long const test_index) const
+    -> std::optional<std::chrono::steady_clock::time_point>
+  {
+    return load_test_start(
+      this->memory_ + RESPONSE_RING_TEST_START_OFFSET,
+      test_index);
+  }
+
+  [[nodiscard]]
+  auto claim_test() const -> bool
+  {
+    return waypoint::internal::claim_test(
+      this->memory_ + RESPONSE_RING_CLAIM_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto revoke_tests(unsigned long long const dispatched_count) const
+    -> unsigned long long
+  {
+    return waypoint::internal::revoke_tests(
+      this->memory_ + RESPONSE_RING_CLAIM_OFFSET,
+      dispatched_count);
+  }
+
+private:
+  void wait_for_space(unsigned long long const observed_head)
+  {
+    this->notify();
+
+    auto const sequence = this->space_futex().load(std::memory_order_seq_cst);
+    this->producer_waiting().store(1, std::memory_order_seq_cst);
+    if(this->head().load(std::memory_order_seq_cst) != observed_head)
+    {
+      return;
+    }
+
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(
+      RESPONSE_RING_PARENT_CHECK_INTERVAL);
+    ::timespec const timeout{
+      seconds.count(),
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        RESPONSE_RING_PARENT_CHECK_INTERVAL - seconds)
+        .count()};
+    ::syscall(
+      SYS_futex,
+      this->space_futex_address(),
+      FUTEX_WAIT,
+      sequence,
+      &timeout,
+      nullptr,
+      0);
+
+    // Processes forked from the owner to run isolated tests
+    // only depend on the owner staying alive
+    auto const expected_parent_pid = ::getpid() == this->owner_pid_
+      ? this->parent_pid_
+      : this->owner_pid_;
+    if(::getppid() != expected_parent_pid)
+    {
+      // Nobody is left to drain the ring
+      waypoint::coverage::gcov_dump();
+
+      // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
+      std::_Exit(EXIT_FAILURE);
+      // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
+    }
+  }
+
+  template<typename T>
+  [[nodiscard]]
+  auto field(unsigned long long const offset) const -> std::atomic_ref<T>
+  {
+    return std::atomic_ref{*reinterpret_cast<T *>(this->memory_ + offset)};
+  }
+
+  [[nodiscard]]
+  auto head() const -> std::atomic_ref<unsigned long long>
+  {
+    return this->field<unsigned long long>(RESPONSE_RING_HEAD_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto tail() const -> std::atomic_ref<unsigned long long>
+  {
+    return this->field<unsigned long long>(RESPONSE_RING_TAIL_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto space_futex() const -> std::atomic_ref<std::uint32_t>
+  {
+    return this->field<std::uint32_t>(RESPONSE_RING_SPACE_FUTEX_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto space_futex_address() const -> std::uint32_t *
+  {
+    return reinterpret_cast<std::uint32_t *>(
+      this->memory_ + RESPONSE_RING_SPACE_FUTEX_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto producer_waiting() const -> std::atomic_ref<std::uint32_t>
+  {
+    return this->field<std::uint32_t>(RESPONSE_RING_PRODUCER_WAITING_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto consumer_waiting() const -> std::atomic_ref<std::uint32_t>
+  {
+    return this->field<std::uint32_t>(RESPONSE_RING_CONSUMER_WAITING_OFFSET);
+  }
+
+  [[nodiscard]]
+  auto data() const -> unsigned char *
+  {
+    return this->memory_ + RESPONSE_RING_HEADER_SIZE;
+  }
+
+  int fd_;
+  int event_fd_;
+  unsigned char *memory_;
+  ::pid_t owner_pid_;
+  ::pid_t parent_pid_;
+  unsigned long long unnotified_bytes_;
+};
+
+ResponseRing::~ResponseRing() = default;
+
+ResponseRing::ResponseRing(ResponseRing_impl *const impl)
+  : impl_{std::unique_ptr<ResponseRing_impl>{impl}}
+{
+}
+
+ResponseRing::ResponseRing(ResponseRing &&other) noexcept = default;
+
+void ResponseRing::push(std::vector<unsigned char> const &frame) const
+{
+  this->impl_->push(frame);
+}
+
+void ResponseRing::notify() const
+{
+  this->impl_->notify();
+}
+
+void ResponseRing::note_test_started(unsigned long long const test_index) const
+{
+  this->impl_->note_test_started(test_index);
+}
+
+auto ResponseRing::claim_test() const -> bool
+{
+  return this->impl_->claim_test();
+}
+
+ResponseWriter::ResponseWriter(
+  InputPipeEnd const &pipe,
+  std::optional<StagingArea> staging_area,
+  std::optional<ResponseRing> response_ring)
+  : pipe_{pipe},
+    staging_area_{std::move(staging_area)},
+    response_ring_{std::move(response_ring)}
+{
+}
+
+void ResponseWriter::stage(Response const &response)
+{
+  auto const frame = encode_response(response);
+  if(this->response_ring_.has_value())
+  {
+    this->response_ring_->push(frame);
+  }
+  else if(!this->staging_area_->append(frame))
+  {
+    this->flush(frame);
+  }
+}
+
+void ResponseWriter::note_test_started(unsigned long long const test_index)
+{
+  if(this->response_ring_.has_value())
+  {
+    this->response_ring_->note_test_started(test_index);
+  }
+  else
+  {
+    this->staging_area_->note_test_started(test_index);
+  }
+}
+
+auto ResponseWriter::claim_test() -> bool
+{
+  if(this->response_ring_.has_value())
+  {
+    return this->response_ring_->claim_test();
+  }
+
+  return this->staging_area_->claim_test();
+}
+
+void ResponseWriter::send(Response const &response)
+{
+  auto const frame = encode_response(response);
+  if(this->response_ring_.has_value())
+  {
+    this->response_ring_->push(frame);
+    this->flush({});
+
+    return;
+  }
+
+  this->flush(frame);
+}
+
+void ResponseWriter::flush(std::vector<unsigned char> const &frame)
+{
+  if(this->response_ring_.has_value())
+  {
+    this->response_ring_->notify();
+  }
+  else
+  {
+    this->flush_staging_area(frame);
+  }
+}
+
+void ResponseWriter::flush_staging_area(
+  std::vector<unsigned char> const &frame)
+{
+  // If the child dies between the write and the clear, the parent
+  // receives the staged frames twice and has to discard the repeats
+  this->pipe_.write({this->staging_area_->staged(), frame});
+  this->staging_area_->clear();
+}
+
+auto get_pipes_from_env() noexcept -> std::pair<OutputPipeEnd, InputPipeEnd>
+{
+  auto const maybe_command_read_pipe =
+    get_env(WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME);
+  auto const maybe_response_write_pipe =
+    get_env(WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME);
+
+  unset_env(WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME);
+  unset_env(WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME);
+
+  auto const raw_command_read_pipe =
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    str2int(maybe_command_read_pipe.value(), 10);
+  auto const raw_response_write_pipe =
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    str2int(maybe_response_write_pipe.value(), 10);
+
+  auto *command_read_pipe = new OutputPipeEnd_impl{raw_command_read_pipe};
+  auto *response_write_pipe =
+    new InputPipeEnd_impl{raw_response_write_pipe, false};
+
+  return {OutputPipeEnd{command_read_pipe}, InputPipeEnd{response_write_pipe}};
+}
+
+auto get_staging_area_from_env() noexcept -> std::optional<StagingArea>
+{
+  auto const maybe_staging_area =
+    get_env(WAYPOINT_INTERNAL_STAGING_AREA_ENV_NAME);
+  if(!maybe_staging_area.has_value())
+  {
+    return std::nullopt;
+  }
+
+  unset_env(WAYPOINT_INTERNAL_STAGING_AREA_ENV_NAME);
+
+  auto const raw_staging_area = str2int(maybe_staging_area.value(), 10);
+
+  return {StagingArea{new StagingArea_impl{raw_staging_area}}};
+}
+
+auto get_response_ring_from_env() noexcept -> std::optional<ResponseRing>
+{
+  auto const maybe_response_ring =
+    get_env(WAYPOINT_INTERNAL_RESPONSE_RING_ENV_NAME);
+  auto const maybe_response_ring_event =
+    get_env(WAYPOINT_INTERNAL_RESPONSE_RING_EVENT_ENV_NAME);
+  if(!maybe_response_ring.has_value())
+  {
+    return std::nullopt;
+  }
+
+  unset_env(WAYPOINT_INTERNAL_RESPONSE_RING_ENV_NAME);
+  unset_env(WAYPOINT_INTERNAL_RESPONSE_RING_EVENT_ENV_NAME);
+
+  auto const raw_response_ring = str2int(maybe_response_ring.value(), 10);
+  auto const raw_response_ring_event =
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    str2int(maybe_response_ring_event.value(), 10);
+
+  return {ResponseRing{
+    new ResponseRing_impl{raw_response_ring, raw_response_ring_event}}};
+}
+
+auto is_child() -> bool
+{
+  auto const maybe_value = get_env(WAYPOINT_INTERNAL_RUNNER_ENV_NAME);
+  if(!maybe_value.has_value())
+  {
+    return false;
+  }
+
+  unset_env(WAYPOINT_INTERNAL_RUNNER_ENV_NAME);
+
+  return maybe_value.value() == WAYPOINT_INTERNAL_RUNNER_ENV_VALUE;
+}
+
+Response::Response(
+  Code const code_,
+  unsigned long long const test_id_,
+  bool const assertion_passed_,
+  unsigned long long const assertion_index_,
+  std::optional<std::string> assertion_message_)
+  : code{code_},
+    test_id{test_id_},
+    assertion_passed{assertion_passed_},
+    assertion_index{assertion_index_},
+    assertion_message{std::move(assertion_message_)},
+    exit_status{},
+    duration_us{}
+{
+}
+
+auto encode_response(Response const &response) -> std::vector<unsigned char>
+{
+  constexpr unsigned char passed_flag = 0x01;
+  constexpr unsigned char has_message_flag = 0x02;
+
+  std::vector<unsigned char> payload;
+  payload.push_back(std::to_underlying(response.code));
+
+  if(response.code == Response::Code::TestComplete)
+  {
+    append_varint(payload, response.test_id);
+    append_varint(payload, response.duration_us);
+  }
+
+  if(response.code == Response::Code::Timeout)
+  {
+    append_varint(payload, response.test_id);
+  }
+
+  if(response.code == Response::Code::TestExited)
+  {
+    append_varint(payload, response.test_id);
+    append_varint(payload, response.exit_status);
+  }
+
+  if(response.code == Response::Code::Assertion)
+  {
+    append_varint(payload, response.test_id);
+    append_varint(payload, response.assertion_index);
+
+    unsigned char flags = response.assertion_passed ? passed_flag : 0;
+    if(response.assertion_message.has_value())
+    {
+      flags |= has_message_flag;
+    }
+    payload.push_back(flags);
+
+    if(response.assertion_message.has_value())
+    {
+      auto const &message = response.assertion_message.value();
+      append_varint(payload, message.size());
+      payload.insert(payload.end(), message.begin(), message.end());
+    }
+  }
+
+  return frame(payload);
+}
+
+auto decode_response(std::vector<unsigned char> const &payload) -> Response
+{
+  constexpr unsigned char passed_flag = 0x01;
+  constexpr unsigned char has_message_flag = 0x02;
+
+  auto const code = static_cast<Response::Code>(payload.at(0));
+  unsigned long long position = 1;
+
+  if(code == Response::Code::TestComplete)
+  {
+    auto const test_id = parse_varint(payload, position).value_or(0);
+
+    Response response{code, test_id, {}, {}, {}};
+    response.duration_us = parse_varint(payload, position).value_or(0);
+
+    return response;
+  }
+
+  if(code == Response::Code::Timeout)
+  {
+    auto const test_id = parse_varint(payload, position).value_or(0);
+
+    return Response{code, test_id, {}, {}, {}};
+  }
+
+  if(code == Response::Code::TestExited)
+  {
+    auto const test_id = parse_varint(payload, position).value_or(0);
+
+    Response response{code, test_id, {}, {}, {}};
+    response.exit_status = parse_varint(payload, position).value_or(0);
+
+    return response;
+  }
+
+  if(code != Response::Code::Assertion)
+  {
+    return Response{code, {}, {}, {}, {}};
+  }
+
+  auto const test_id = parse_varint(payload, position).value_or(0);
+  auto const assertion_index = parse_varint(payload, position).value_or(0);
+  auto const flags = payload.at(position++);
+
+  if((flags & has_message_flag) == 0)
+  {
+    return Response{
+      code,
+      test_id,
+      (flags & passed_flag) != 0,
+      assertion_index,
+      std::nullopt};
+  }
+
+  auto const message_size = parse_varint(payload, position).value_or(0);
+  auto const *const message_begin =
+    reinterpret_cast<char const *>(payload.data() + position);
+
+  return Response{
+    code,
+    test_id,
+    (flags & passed_flag) != 0,
+    assertion_index,
+    std::string{message_begin, message_size}};
+}
+
+auto encode_command(Command const &command) -> std::vector<unsigned char>
+{
+  std::vector<unsigned char> payload;
+  payload.push_back(std::to_underlying(command.code));
+
+  if(
+    command.code == Command::Code::RunTest ||
+    command.code == Command::Code::RunIsolatedTest)
+  {
+    append_varint(payload, command.test_index);
+  }
+
+  return frame(payload);
+}
+
+auto decode_command(std::vector<unsigned char> const &payload) -> Command
+{
+  auto const code = static_cast<Command::Code>(payload.at(0));
+  if(code != Command::Code::RunTest && code != Command::Code::RunIsolatedTest)
+  {
+    return {code, {}};
+  }
+
+  unsigned long long position = 1;
+  auto const test_index = parse_varint(payload, position).value_or(0);
+
+  return {code, test_index};
+}
+
+} // namespace waypoint::internal
+
+namespace
+{
+
+auto resolve_path(std::string const &input) noexcept -> std::string
+{
+  std::vector<char> dest;
+  constexpr unsigned long long bufsize = 4'096;
+  dest.resize(bufsize);
+  std::ranges::fill(dest, 0);
+
+  [[maybe_unused]]
+  char const *const ret = ::realpath(input.c_str(), dest.data());
+
+  return {dest.data()};
+}
+
+auto get_path_to_current_executable() noexcept -> std::string
+{
+  std::vector<char> dest;
+  constexpr unsigned long long bufsize = 4'096;
+
+  dest.resize(bufsize);
+  std::ranges::fill(dest, 0);
+
+  [[maybe_unused]]
+  auto const ret = ::readlink("/proc/self/exe", dest.data(), bufsize);
+
+  std::string const path{dest.data()};
+
+  return resolve_path(path);
+}
+
+auto create_child_process(
+  std::array<int, 2> const &pipe_command,
+  std::array<int, 2> const &pipe_response,
+  std::vector<std::pair<char const *, int>> const &shared_fds) noexcept
+  -> std::tuple<int, int, int>
+{
+  auto const fork_ret = ::fork();
+  if(fork_ret > 0)
+  {
+    auto const child_pid = fork_ret;
+
+    ::close(pipe_command[0]);
+    ::close(pipe_response[1]);
+
+    return {child_pid, pipe_command[1], pipe_response[0]};
+  }
+
+  ::close(pipe_command[1]);
+  ::close(pipe_response[0]);
+
+  // The child's own pipe ends must survive execve;
+  // everything else the parent holds is close-on-exec
+  ::fcntl(pipe_command[0], F_SETFD, 0);
+  ::fcntl(pipe_response[1], F_SETFD, 0);
+  for(auto const &[env_name, fd] : shared_fds)
+  {
+    ::fcntl(fd, F_SETFD, 0);
+  }
+
+  auto const path_to_exe = get_path_to_current_executable();
+
+  std::array<char const *, 2> const execve_argv = {
+    path_to_exe.c_str(),
+    nullptr};
+
+  auto const runner_mode_env = std::format(
+    "{}={}",
+    WAYPOINT_INTERNAL_RUNNER_ENV_NAME,
+    WAYPOINT_INTERNAL_RUNNER_ENV_VALUE);
+  auto const command_source_env = std::format(
+    "{}={}",
+    WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME,
+    int2str(pipe_command[0], 10));
+  auto const response_sink_env = std::format(
+    "{}={}",
+    WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME,
+    int2str(pipe_response[1], 10));
+
+  std::vector<std::string> shared_fd_envs;
+  for(auto const &[env_name, fd] : shared_fds)
+  {
+    shared_fd_envs.push_back(std::format("{}={}", env_name, int2str(fd, 10)));
+  }
+
+  std::vector execve_envp = {
+    runner_mode_env.c_str(),
+    command_source_env.c_str(),
+    response_sink_env.c_str()};
+
+  for(auto const &env : shared_fd_envs)
+  {
+    execve_envp.push_back(env.c_str());
+  }
+
+  // ::environ is declared in <unistd.h>
+  for(auto const *e = ::environ; *e != nullptr; ++e)
+  {
+    execve_envp.push_back(*e);
+  }
+
+  execve_envp.push_back(nullptr);
+
+  waypoint::coverage::gcov_dump();
+
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
+  ::execve(
+    path_to_exe.c_str(),
+    const_cast<char *const *>(execve_argv.data()),
+    const_cast<char *const *>(execve_envp.data()));
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
+
+  std::unreachable();
+}
+
+auto create_shared_memory(char const *const name, unsigned long long const size)
+  -> int
+{
+  auto const fd = ::memfd_create(name, MFD_CLOEXEC);
+  waypoint::internal::assert(fd >= 0, "Failed to create shared memory");
+
+  [[maybe_unused]]
+  auto const ret = ::ftruncate(fd, static_cast<::off_t>(size));
+
+  return fd;
+}
+
+auto create_pipes() noexcept
+  -> std::pair<std::array<int, 2>, std::array<int, 2>>
+{
+  std::array<int, 2> pipe_command{};
+  std::array<int, 2> pipe_response{};
+
+  [[maybe_unused]]
+  auto const ret1 = ::pipe2(pipe_command.data(), O_CLOEXEC);
+  [[maybe_unused]]
+  auto const ret2 = ::pipe2(pipe_response.data(), O_CLOEXEC);
+
+  return {pipe_command, pipe_response};
+}
+
+// std::chrono::steady_clock is CLOCK_MONOTONIC on Linux
+auto arm_deadline_timer(std::chrono::steady_clock::time_point const deadline)
+  -> int
+{
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_BR_START
+  static int const raw_deadline_timer =
+    ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_BR_STOP
+  waypoint::internal::assert(
+    raw_deadline_timer >= 0,
+    "Failed to create deadline timer");
+
+  auto const since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    deadline.time_since_epoch());
+  auto const seconds =
+    std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+
+  ::itimerspec spec{};
+  spec.it_value.tv_sec = seconds.count();
+  spec.it_value.tv_nsec = (since_epoch - seconds).count();
+  // A zero it_value would disarm the timer instead
+  if(spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+  {
+    spec.it_value.tv_nsec = 1;
+  }
+
+  // Expirations are never read, rearming the timer resets them
+  [[maybe_unused]]
+  auto const ret =
+    ::timerfd_settime(raw_deadline_timer, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+  return raw_deadline_timer;
+}
+
+void poll_until_ready(std::vector<::pollfd> &poll_fds, int const timeout_ms)
+{
+  while(::poll(poll_fds.data(), poll_fds.size(), timeout_ms) < 0)
+  {
+    // Interrupted by a signal, try again
+    waypoint::internal::assert(errno == EINTR, "Unexpected poll error");
+  }
+}
+
+auto wait_for_raw_exit_status(int const child_pid) -> int
 {
   int status = 0;
   [[maybe_unused]]
   auto const ret = ::waitpid(child_pid, &status, 0);
 
+  return status;
+}
+
+auto decode_exit_status(int const status) -> unsigned long long
+{
   if(WIFEXITED(status))
   {
-    return WEXITSTATUS(status);
+    return WEXITSTATUS(status);
+  }
+
+  // process did not exit normally, therefore
+  // probably WIFSIGNALED(status) == true
+  waypoint::internal::assert(
+    WIFSIGNALED(status),
+    "Expected WIFSIGNALED(status) to be true");
+
+  return WTERMSIG(status);
+}
+
+auto wait_for_child_process_end(int const child_pid) -> unsigned long long
+{
+  return decode_exit_status(wait_for_raw_exit_status(child_pid));
+}
+
+// Kills the child if it is still running after timeout_ms
+auto wait_for_child_process_end(
+  int const child_pid,
+  unsigned long long const timeout_ms) -> std::optional<unsigned long long>
+{
+  auto const raw_pidfd =
+    static_cast<int>(::syscall(SYS_pidfd_open, child_pid, 0));
+  waypoint::internal::assert(raw_pidfd >= 0, "Failed to open pidfd");
+
+  std::vector<::pollfd> poll_fds{::pollfd{raw_pidfd, POLLIN, 0}};
+  poll_until_ready(poll_fds, static_cast<int>(timeout_ms));
+  ::close(raw_pidfd);
+
+  if(poll_fds[0].revents == 0)
+  {
+    ::kill(child_pid, SIGKILL);
+    [[maybe_unused]]
+    auto const status = wait_for_raw_exit_status(child_pid);
+
+    return std::nullopt;
+  }
+
+  return wait_for_child_process_end(child_pid);
+}
+
+auto thread_count() -> unsigned long long
+{
+  std::ifstream status{"/proc/self/status"};
+
+  std::string key;
+  while(status >> key)
+  {
+    if(key == "Threads:")
+    {
+      unsigned long long count = 0;
+      status >> count;
+
+      return count;
+    }
+  }
+
+  return 0;
+}
+
+void send_message(
+  int const socket,
+  std::span<unsigned char const> const payload,
+  std::span<int const> const fds)
+{
+  ::iovec iov{
+    const_cast<unsigned char *>(payload.data()),
+    payload.size()};
+  std::array<char, CMSG_SPACE(sizeof(int) * ZYGOTE_MAX_FDS)> control{};
+
+  ::msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  if(!fds.empty())
+  {
+    message.msg_control = control.data();
+    message.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+
+    auto *const header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+    std::ranges::copy(fds, reinterpret_cast<int *>(CMSG_DATA(header)));
+  }
+
+  while(::sendmsg(socket, &message, MSG_NOSIGNAL) < 0)
+  {
+    waypoint::internal::assert(errno == EINTR, "Failed to message the zygote");
+  }
+}
+
+// Returns false once the other end of the socket is closed
+auto receive_message(
+  int const socket,
+  std::vector<unsigned char> &payload,
+  std::vector<int> &fds) -> bool
+{
+  payload.resize(ZYGOTE_MAX_MESSAGE_SIZE);
+  fds.clear();
+
+  ::iovec iov{payload.data(), payload.size()};
+  std::array<char, CMSG_SPACE(sizeof(int) * ZYGOTE_MAX_FDS)> control{};
+
+  ::msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data();
+  message.msg_controllen = control.size();
+
+  auto ret = ::recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+  while(ret < 0 && errno == EINTR)
+  {
+    ret = ::recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+  }
+
+  if(ret <= 0)
+  {
+    return false;
+  }
+
+  payload.resize(static_cast<unsigned long long>(ret));
+
+  for(auto *header = CMSG_FIRSTHDR(&message); header != nullptr;
+      header = CMSG_NXTHDR(&message, header))
+  {
+    if(header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS)
+    {
+      auto const count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      auto const *const received =
+        reinterpret_cast<int const *>(CMSG_DATA(header));
+      fds.insert(fds.end(), received, received + count);
+    }
+  }
+
+  return true;
+}
+
+template<typename T>
+auto to_bytes(T const value) -> std::array<unsigned char, sizeof(T)>
+{
+  return std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+}
+
+template<typename T>
+auto from_bytes(std::span<unsigned char const> const bytes) -> T
+{
+  std::array<unsigned char, sizeof(T)> value{};
+  std::ranges::copy(bytes.first(sizeof(T)), value.begin());
+
+  return std::bit_cast<T>(value);
+}
+
+// Runs in the worker right after it is forked from the zygote and
+// leaves the same environment a freshly exec'd child process would see
+void become_worker(
+  int const zygote_socket,
+  std::span<unsigned char const> const env_names,
+  std::span<int const> const fds)
+{
+  ::close(zygote_socket);
+
+  set_env(
+    WAYPOINT_INTERNAL_RUNNER_ENV_NAME,
+    WAYPOINT_INTERNAL_RUNNER_ENV_VALUE);
+
+  auto names = std::string_view{
+    reinterpret_cast<char const *>(env_names.data()),
+    env_names.size()};
+  for(auto const fd : fds)
+  {
+    auto const name = names.substr(0, names.find('\0'));
+    names.remove_prefix(std::min(names.size(), name.size() + 1));
+
+    set_env(std::string{name}, int2str(fd, 10));
   }
+}
 
-  // process did not exit normally, therefore
-  // probably WIFSIGNALED(status) == true
-  waypoint::internal::assert(
-    WIFSIGNALED(status),
-    "Expected WIFSIGNALED(status) to be true");
+// Serves spawn and wait requests until the parent goes away.
+// Returns true in a freshly forked worker.
+auto serve_zygote(int const socket) -> bool
+{
+  std::vector<unsigned char> request;
+  std::vector<int> fds;
+  while(receive_message(socket, request, fds))
+  {
+    auto const request_payload = std::span{request}.subspan(1);
+    if(request.front() == ZYGOTE_SPAWN_REQUEST)
+    {
+      auto const worker_pid = ::fork();
+      if(worker_pid == 0)
+      {
+        become_worker(socket, request_payload, fds);
 
-  return WTERMSIG(status);
+        return true;
+      }
+
+      for(auto const fd : fds)
+      {
+        ::close(fd);
+      }
+
+      send_message(socket, to_bytes(worker_pid), {});
+    }
+    else
+    {
+      auto const status =
+        wait_for_raw_exit_status(from_bytes<::pid_t>(request_payload));
+
+      send_message(socket, to_bytes(status), {});
+    }
+  }
+
+  return false;
 }
 
 } // namespace
@@ -405,19 +1886,357 @@ auto wait_for_child_process_end(int const child_pid) -> unsigned long long
 namespace waypoint::internal
 {
 
+class Zygote_impl
+{
+public:
+  ~Zygote_impl()
+  {
+    // The zygote exits once it sees the socket closed
+    ::close(this->socket_);
+    [[maybe_unused]]
+    auto const exit_status = wait_for_child_process_end(this->pid_);
+  }
+
+  Zygote_impl(int const pid, int const socket)
+    : pid_{pid},
+      socket_{socket}
+  {
+  }
+
+  Zygote_impl() = delete;
+  Zygote_impl(Zygote_impl const &other) = delete;
+  Zygote_impl(Zygote_impl &&other) noexcept = delete;
+  auto operator=(Zygote_impl const &other) -> Zygote_impl & = delete;
+  auto operator=(Zygote_impl &&other) noexcept -> Zygote_impl & = delete;
+
+  [[nodiscard]]
+  auto spawn(
+    std::array<int, 2> const &pipe_command,
+    std::array<int, 2> const &pipe_response,
+    std::vector<std::pair<char const *, int>> const &shared_fds) const
+    -> std::tuple<int, int, int>
+  {
+    std::vector<unsigned char> request{ZYGOTE_SPAWN_REQUEST};
+    std::vector<int> fds;
+    auto const add_fd = [&request, &fds](char const *const name, int const fd)
+    {
+      request.insert(request.end(), name, name + std::strlen(name) + 1);
+      fds.push_back(fd);
+    };
+
+    add_fd(WAYPOINT_INTERNAL_COMMAND_SOURCE_ENV_NAME, pipe_command[0]);
+    add_fd(WAYPOINT_INTERNAL_RESPONSE_SINK_ENV_NAME, pipe_response[1]);
+    for(auto const &[env_name, fd] : shared_fds)
+    {
+      add_fd(env_name, fd);
+    }
+
+    send_message(this->socket_, request, fds);
+
+    ::close(pipe_command[0]);
+    ::close(pipe_response[1]);
+
+    std::vector<unsigned char> reply;
+    std::vector<int> no_fds;
+    auto const received = receive_message(this->socket_, reply, no_fds);
+    waypoint::internal::assert(received, "The zygote exited unexpectedly");
+
+    return {from_bytes<::pid_t>(reply), pipe_command[1], pipe_response[0]};
+  }
+
+  [[nodiscard]]
+  auto wait(int const child_pid) const -> unsigned long long
+  {
+    std::vector<unsigned char> request{ZYGOTE_WAIT_REQUEST};
+    std::ranges::copy(to_bytes(child_pid), std::back_inserter(request));
+
+    send_message(this->socket_, request, {});
+
+    std::vector<unsigned char> reply;
+    std::vector<int> no_fds;
+    auto const received = receive_message(this->socket_, reply, no_fds);
+    waypoint::internal::assert(received, "The zygote exited unexpectedly");
+
+    return decode_exit_status(from_bytes<int>(reply));
+  }
+
+private:
+  int pid_;
+  int socket_;
+};
+
+Zygote::~Zygote() = default;
+
+Zygote::Zygote(Zygote_impl *const impl)
+  : impl_{std::unique_ptr<Zygote_impl>{impl}}
+{
+}
+
+Zygote::Zygote(Zygote &&other) noexcept = default;
+
+auto start_zygote() noexcept -> std::optional<Zygote>
+{
+  // Only the calling thread survives fork, so any other thread could
+  // leave locks held forever in the zygote and every worker
+  if(thread_count() != 1)
+  {
+    return std::nullopt;
+  }
+
+  std::array<int, 2> sockets{};
+  [[maybe_unused]]
+  auto const ret = ::socketpair(
+    AF_UNIX,
+    SOCK_SEQPACKET | SOCK_CLOEXEC,
+    0,
+    sockets.data());
+
+  // Buffered output would otherwise be written again by every worker
+  std::fflush(nullptr);
+
+  auto const zygote_pid = ::fork();
+  if(zygote_pid > 0)
+  {
+    ::close(sockets[1]);
+
+    return {Zygote{new Zygote_impl{zygote_pid, sockets[0]}}};
+  }
+
+  ::close(sockets[0]);
+
+  if(serve_zygote(sockets[1]))
+  {
+    return std::nullopt;
+  }
+
+  waypoint::coverage::gcov_dump();
+
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
+  std::_Exit(EXIT_SUCCESS);
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
+}
+
+auto run_in_forked_process(
+  std::function<void()> const &f,
+  unsigned long long const timeout_ms) -> std::optional<unsigned long long>
+{
+  // Buffered output would otherwise be written by both processes
+  std::fflush(nullptr);
+
+  auto const parent_pid = ::getpid();
+  auto const child_pid = ::fork();
+  if(child_pid > 0)
+  {
+    if(timeout_ms == 0)
+    {
+      return wait_for_child_process_end(child_pid);
+    }
+
+    return wait_for_child_process_end(child_pid, timeout_ms);
+  }
+
+  // The test dies with the worker, which the runner may kill at its
+  // own deadline or when it stops the run, even if the worker died
+  // before this took effect
+  ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+  if(::getppid() != parent_pid)
+  {
+    // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
+    std::_Exit(EXIT_FAILURE);
+    // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
+  }
+
+  f();
+
+  waypoint::coverage::gcov_dump();
+
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
+  std::_Exit(EXIT_SUCCESS);
+  // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
+}
+
+class ReadOnlyRegion_impl
+{
+public:
+  ~ReadOnlyRegion_impl()
+  {
+    ::munmap(const_cast<unsigned char *>(this->memory_), this->size_);
+    ::close(this->fd_);
+  }
+
+  ReadOnlyRegion_impl(int const fd, unsigned long long const size)
+    : fd_{fd},
+      size_{size},
+      memory_{static_cast<unsigned char const *>(
+        ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0))}
+  {
+    waypoint::internal::assert(
+      this->memory_ != MAP_FAILED,
+      "Failed to map the read-only region");
+  }
+
+  ReadOnlyRegion_impl() = delete;
+  ReadOnlyRegion_impl(ReadOnlyRegion_impl const &other) = delete;
+  ReadOnlyRegion_impl(ReadOnlyRegion_impl &&other) noexcept = delete;
+  auto operator=(ReadOnlyRegion_impl const &other)
+    -> ReadOnlyRegion_impl & = delete;
+  auto operator=(ReadOnlyRegion_impl &&other) noexcept
+    -> ReadOnlyRegion_impl & = delete;
+
+  [[nodiscard]]
+  auto raw_fd() const -> int
+  {
+    return this->fd_;
+  }
+
+  [[nodiscard]]
+  auto data() const -> unsigned char const *
+  {
+    return this->memory_;
+  }
+
+  [[nodiscard]]
+  auto size() const -> unsigned long long
+  {
+    return this->size_;
+  }
+
+private:
+  int fd_;
+  unsigned long long size_;
+  unsigned char const *memory_;
+};
+
+ReadOnlyRegion::~ReadOnlyRegion() = default;
+
+ReadOnlyRegion::ReadOnlyRegion(ReadOnlyRegion_impl *const impl)
+  : impl_{std::unique_ptr<ReadOnlyRegion_impl>{impl}}
+{
+}
+
+ReadOnlyRegion::ReadOnlyRegion(ReadOnlyRegion &&other) noexcept = default;
+
+auto ReadOnlyRegion::data() const -> unsigned char const *
+{
+  return this->impl_->data();
+}
+
+auto ReadOnlyRegion::size() const -> unsigned long long
+{
+  return this->impl_->size();
+}
+
+auto create_read_only_region(
+  unsigned long long const size,
+  std::function<void(unsigned char *)> const &fill) noexcept -> ReadOnlyRegion
+{
+  auto const fd =
+    ::memfd_create("waypoint_shared_data", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  waypoint::internal::assert(fd >= 0, "Failed to create shared memory");
+
+  [[maybe_unused]]
+  auto const ret = ::ftruncate(fd, static_cast<::off_t>(size));
+
+  auto *const memory = static_cast<unsigned char *>(
+    ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+  waypoint::internal::assert(
+    memory != MAP_FAILED,
+    "Failed to map the read-only region");
+  fill(memory);
+  ::munmap(memory, size);
+
+  // Writable mappings would make sealing fail, so none may remain
+  auto const sealed = ::fcntl(
+    fd,
+    F_ADD_SEALS,
+    F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+  waypoint::internal::assert(sealed == 0, "Failed to seal shared memory");
+
+  return ReadOnlyRegion{new ReadOnlyRegion_impl{fd, size}};
+}
+
+auto get_read_only_region_from_env() noexcept
+  -> std::optional<ReadOnlyRegion>
+{
+  auto const maybe_shared_data =
+    get_env(WAYPOINT_INTERNAL_SHARED_DATA_ENV_NAME);
+  if(!maybe_shared_data.has_value())
+  {
+    return std::nullopt;
+  }
+
+  unset_env(WAYPOINT_INTERNAL_SHARED_DATA_ENV_NAME);
+
+  auto const raw_shared_data = str2int(maybe_shared_data.value(), 10);
+
+  struct ::stat status{};
+  [[maybe_unused]]
+  auto const ret = ::fstat(raw_shared_data, &status);
+
+  return {ReadOnlyRegion{new ReadOnlyRegion_impl{
+    raw_shared_data,
+    static_cast<unsigned long long>(status.st_size)}}};
+}
+
 class ChildProcess_impl
 {
 public:
   ~ChildProcess_impl() = default;
 
-  ChildProcess_impl()
+  ChildProcess_impl(
+    Transport const transport,
+    Zygote_impl const *const zygote,
+    ReadOnlyRegion_impl const *const shared_data)
+    : response_pipe_closed_{false}
   {
+    std::vector<std::pair<char const *, int>> shared_fds;
+    if(shared_data != nullptr)
+    {
+      shared_fds.emplace_back(
+        WAYPOINT_INTERNAL_SHARED_DATA_ENV_NAME,
+        shared_data->raw_fd());
+    }
+
+    if(transport == Transport::SharedMemory)
+    {
+      auto const raw_response_ring = create_shared_memory(
+        "waypoint_response_ring",
+        RESPONSE_RING_HEADER_SIZE + RESPONSE_RING_CAPACITY);
+      auto const raw_response_ring_event =
+        ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      shared_fds.emplace_back(
+        WAYPOINT_INTERNAL_RESPONSE_RING_ENV_NAME,
+        raw_response_ring);
+      shared_fds.emplace_back(
+        WAYPOINT_INTERNAL_RESPONSE_RING_EVENT_ENV_NAME,
+        raw_response_ring_event);
+      this->response_ring_ = std::make_unique<ResponseRing_impl>(
+        raw_response_ring,
+        raw_response_ring_event);
+    }
+    else
+    {
+      auto const raw_staging_area =
+        create_shared_memory("waypoint_staging_area", STAGING_AREA_SIZE);
+      shared_fds.emplace_back(
+        WAYPOINT_INTERNAL_STAGING_AREA_ENV_NAME,
+        raw_staging_area);
+      this->staging_area_ = std::make_unique<StagingArea>(
+        new StagingArea_impl{raw_staging_area});
+    }
+
+    auto const [pipe_command, pipe_response] = create_pipes();
     auto const [child_pid, raw_command_write_pipe, raw_response_read_pipe] =
-      create_child_process_with_pipes();
+      zygote == nullptr
+      ? create_child_process(pipe_command, pipe_response, shared_fds)
+      : zygote->spawn(pipe_command, pipe_response, shared_fds);
+
+    this->zygote_ = zygote;
 
     this->child_pid_ = child_pid;
+    this->raw_response_read_pipe_ = raw_response_read_pipe;
     this->command_write_pipe_ = std::make_unique<InputPipeEnd>(
-      new InputPipeEnd_impl{raw_command_write_pipe});
+      new InputPipeEnd_impl{raw_command_write_pipe, true});
     this->response_read_pipe_ = std::make_unique<OutputPipeEnd>(
       new OutputPipeEnd_impl{raw_response_read_pipe});
   }
@@ -435,26 +2254,171 @@ public:
     return *this->command_write_pipe_;
   }
 
+  auto read_response_frame(std::vector<unsigned char> &payload)
+    -> OutputPipeEnd::ReadResult
+  {
+    if(!this->response_ring_)
+    {
+      return this->response_read_pipe_->read_frame(payload);
+    }
+
+    while(!this->frame_buffer_.take_frame(payload))
+    {
+      if(this->response_ring_->pull(this->frame_buffer_))
+      {
+        continue;
+      }
+
+      // Everything the child wrote before exiting has been drained
+      if(this->response_pipe_closed_)
+      {
+        return OutputPipeEnd::ReadResult::PipeClosed;
+      }
+
+      std::vector<::pollfd> poll_fds;
+      auto const buffered = this->prepare_to_poll(poll_fds);
+      poll_until_ready(poll_fds, buffered ? 0 : -1);
+      [[maybe_unused]]
+      auto const ready = this->finish_polling(poll_fds);
+    }
+
+    return OutputPipeEnd::ReadResult::Success;
+  }
+
+  [[nodiscard]]
+  auto has_buffered_response() const -> bool
+  {
+    if(!this->response_ring_)
+    {
+      return this->response_read_pipe_->has_buffered_frame();
+    }
+
+    return this->frame_buffer_.next_frame().has_value() ||
+      !this->response_ring_->is_empty() || this->response_pipe_closed_;
+  }
+
+  [[nodiscard]]
+  auto staged_payloads() const -> std::vector<std::vector<unsigned char>>
+  {
+    if(!this->staging_area_)
+    {
+      return {};
+    }
+
+    return this->staging_area_->staged_payloads();
+  }
+
   [[nodiscard]]
-  auto response_read_pipe() const -> OutputPipeEnd const &
+  auto test_start_time(unsigned long long const test_index) const
+    -> std::optional<std::chrono::steady_clock::time_point>
+  {
+    if(this->response_ring_)
+    {
+      return this->response_ring_->test_start_time(test_index);
+    }
+
+    return this->staging_area_->test_start_time(test_index);
+  }
+
+  [[nodiscard]]
+  auto revoke_tests(unsigned long long const dispatched_count) const
+    -> unsigned long long
+  {
+    if(this->response_ring_)
+    {
+      return this->response_ring_->revoke_tests(dispatched_count);
+    }
+
+    return this->staging_area_->revoke_tests(dispatched_count);
+  }
+
+  void kill() const
   {
-    return *this->response_read_pipe_;
+    ::kill(this->child_pid_, SIGKILL);
   }
 
   [[nodiscard]]
   auto wait() const -> unsigned long long
   {
+    if(this->zygote_ != nullptr)
+    {
+      return this->zygote_->wait(this->child_pid_);
+    }
+
     return wait_for_child_process_end(this->child_pid_);
   }
 
+  // Adds poll_fd_count() descriptors to poll on and returns true if
+  // there is already something to read, so polling must not block
+  [[nodiscard]]
+  auto prepare_to_poll(std::vector<::pollfd> &poll_fds) const -> bool
+  {
+    auto const buffered = this->has_buffered_response();
+
+    poll_fds.push_back(::pollfd{this->raw_response_read_pipe_, POLLIN, 0});
+    if(!this->response_ring_)
+    {
+      return buffered;
+    }
+
+    poll_fds.push_back(
+      ::pollfd{this->response_ring_->raw_event_fd(), POLLIN, 0});
+
+    return this->response_ring_->prepare_to_wait() || buffered;
+  }
+
+  // Returns true if any of the descriptors added by prepare_to_poll
+  // became ready
+  auto finish_polling(std::span<::pollfd const> const poll_fds) -> bool
+  {
+    auto const is_ready = [](::pollfd const &poll_fd)
+    {
+      return (poll_fd.revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+    };
+
+    if(!this->response_ring_)
+    {
+      return is_ready(poll_fds[0]);
+    }
+
+    this->response_ring_->finish_waiting();
+
+    // The pipe carries no data in this mode, so readable means closed
+    if(is_ready(poll_fds[0]))
+    {
+      this->response_pipe_closed_ = true;
+    }
+
+    return is_ready(poll_fds[0]) || is_ready(poll_fds[1]) ||
+      !this->response_ring_->is_empty();
+  }
+
+  [[nodiscard]]
+  auto poll_fd_count() const -> unsigned long long
+  {
+    return this->response_ring_ ? 2 : 1;
+  }
+
 private:
   int child_pid_;
+  Zygote_impl const *zygote_;
+  int raw_response_read_pipe_;
   std::unique_ptr<InputPipeEnd> command_write_pipe_;
   std::unique_ptr<OutputPipeEnd> response_read_pipe_;
+  std::unique_ptr<StagingArea> staging_area_;
+  std::unique_ptr<ResponseRing_impl> response_ring_;
+  FrameBuffer frame_buffer_;
+  bool response_pipe_closed_;
 };
 
-ChildProcess::ChildProcess()
-  : impl_{std::make_unique<ChildProcess_impl>()}
+ChildProcess::ChildProcess(
+  Transport const transport,
+  Zygote const *const zygote,
+  ReadOnlyRegion const *const shared_data)
+  : impl_{std::make_unique<ChildProcess_impl>(
+      transport,
+      zygote == nullptr ? nullptr : zygote->impl_.get(),
+      shared_data == nullptr ? nullptr : shared_data->impl_.get())}
 {
 }
 
@@ -465,9 +2429,38 @@ auto ChildProcess::command_write_pipe() const -> InputPipeEnd const &
   return this->impl_->command_write_pipe();
 }
 
-auto ChildProcess::response_read_pipe() const -> OutputPipeEnd const &
+auto ChildProcess::read_response_frame(
+  std::vector<unsigned char> &payload) const -> OutputPipeEnd::ReadResult
+{
+  return this->impl_->read_response_frame(payload);
+}
+
+auto ChildProcess::has_buffered_response() const -> bool
+{
+  return this->impl_->has_buffered_response();
+}
+
+auto ChildProcess::staged_payloads() const
+  -> std::vector<std::vector<unsigned char>>
+{
+  return this->impl_->staged_payloads();
+}
+
+auto ChildProcess::test_start_time(unsigned long long const test_index) const
+  -> std::optional<std::chrono::steady_clock::time_point>
+{
+  return this->impl_->test_start_time(test_index);
+}
+
+auto ChildProcess::revoke_tests(
+  unsigned long long const dispatched_count) const -> unsigned long long
+{
+  return this->impl_->revoke_tests(dispatched_count);
+}
+
+void ChildProcess::kill() const
 {
-  return this->impl_->response_read_pipe();
+  this->impl_->kill();
 }
 
 auto ChildProcess::wait() const -> unsigned long long
@@ -475,4 +2468,45 @@ auto ChildProcess::wait() const -> unsigned long long
   return this->impl_->wait();
 }
 
+auto wait_for_readable(
+  std::vector<ChildProcess const *> const &children,
+  std::optional<std::chrono::steady_clock::time_point> const deadline)
+  -> std::vector<unsigned long long>
+{
+  std::vector<::pollfd> poll_fds;
+  std::vector<bool> buffered;
+  for(auto const *const child : children)
+  {
+    buffered.push_back(child->impl_->prepare_to_poll(poll_fds));
+  }
+
+  // Polled last, so the children's descriptors keep their positions
+  if(deadline.has_value())
+  {
+    auto const raw_deadline_timer = arm_deadline_timer(deadline.value());
+    poll_fds.push_back(::pollfd{raw_deadline_timer, POLLIN, 0});
+  }
+
+  // Frames already buffered would never wake up poll, so do not block
+  auto const any_buffered =
+    std::ranges::find(buffered, true) != buffered.end();
+  poll_until_ready(poll_fds, any_buffered ? 0 : -1);
+
+  std::vector<unsigned long long> ready;
+  auto remaining_poll_fds = std::span<::pollfd const>{poll_fds};
+  for(unsigned long long i = 0; i < children.size(); ++i)
+  {
+    auto &impl = *children[i]->impl_;
+    auto const count = impl.poll_fd_count();
+    if(impl.finish_polling(remaining_poll_fds.first(count)) || buffered[i])
+    {
+      ready.push_back(i);
+    }
+
+    remaining_poll_fds = remaining_poll_fds.subspan(count);
+  }
+
+  return ready;
+}
+
 } // namespace waypoint::internal
@@ -0,0 +1,31 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace waypoint::internal
+{
+
+// Wall times of tests in microseconds, keyed by group and test name
+using TestDurations =
+  std::map<std::pair<std::string, std::string>, unsigned long long>;
+
+// Returns no durations if the file cannot be read. A damaged file
+// yields the durations recorded before the damage.
+[[nodiscard]]
+auto read_timing_database(std::string const &path) -> TestDurations;
+
+// Replaces the stored durations of the given tests and keeps the rest.
+// Concurrent writers take turns through a lock file next to the
+// database, and readers never see a partially written one. Failing
+// to write is not an error, the durations only guide scheduling.
+void update_timing_database(
+  std::string const &path,
+  TestDurations const &durations);
+
+} // namespace waypoint::internal
@@ -0,0 +1,237 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "timing_database.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/file.h>
+
+namespace
+{
+
+// Identifies the format, so that a changed one is not misread
+constexpr char const TIMING_DATABASE_MAGIC[] = "waypoint-timings-1\n";
+
+void append_varint(std::vector<unsigned char> &buffer, unsigned long long value)
+{
+  constexpr unsigned char continuation = 0x80;
+  constexpr unsigned char payload_mask = 0x7f;
+  constexpr unsigned char payload_bits = 7;
+
+  while(value >= continuation)
+  {
+    buffer.push_back(
+      static_cast<unsigned char>(value & payload_mask) | continuation);
+    value >>= payload_bits;
+  }
+
+  buffer.push_back(static_cast<unsigned char>(value));
+}
+
+auto parse_varint(
+  std::vector<unsigned char> const &buffer,
+  unsigned long long &position) -> std::optional<unsigned long long>
+{
+  constexpr unsigned char continuation = 0x80;
+  constexpr unsigned char payload_mask = 0x7f;
+  constexpr unsigned char payload_bits = 7;
+  constexpr unsigned max_shift = 63;
+
+  unsigned long long value = 0;
+  unsigned shift = 0;
+  for(auto i = position; i < buffer.size() && shift <= max_shift; ++i)
+  {
+    value |= static_cast<unsigned long long>(buffer[i] & payload_mask) << shift;
+    shift += payload_bits;
+
+    if((buffer[i] & continuation) == 0)
+    {
+      position = i + 1;
+
+      return value;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void append_string(std::vector<unsigned char> &buffer, std::string const &str)
+{
+  append_varint(buffer, str.size());
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+auto parse_string(
+  std::vector<unsigned char> const &buffer,
+  unsigned long long &position) -> std::optional<std::string>
+{
+  auto const maybe_size = parse_varint(buffer, position);
+  if(
+    !maybe_size.has_value() ||
+    buffer.size() - position < maybe_size.value())
+  {
+    return std::nullopt;
+  }
+
+  auto const *const begin =
+    reinterpret_cast<char const *>(buffer.data() + position);
+  position += maybe_size.value();
+
+  return std::string{begin, maybe_size.value()};
+}
+
+// Each record is the group name, the test name and the duration,
+// with lengths and durations stored as varints
+auto encode(waypoint::internal::TestDurations const &durations)
+  -> std::vector<unsigned char>
+{
+  std::vector<unsigned char> buffer{
+    std::begin(TIMING_DATABASE_MAGIC),
+    std::end(TIMING_DATABASE_MAGIC) - 1};
+  for(auto const &[key, duration_us] : durations)
+  {
+    append_string(buffer, key.first);
+    append_string(buffer, key.second);
+    append_varint(buffer, duration_us);
+  }
+
+  return buffer;
+}
+
+auto decode(std::vector<unsigned char> const &buffer)
+  -> waypoint::internal::TestDurations
+{
+  std::string const magic{TIMING_DATABASE_MAGIC};
+  if(
+    buffer.size() < magic.size() ||
+    !std::equal(magic.begin(), magic.end(), buffer.begin()))
+  {
+    return {};
+  }
+
+  waypoint::internal::TestDurations durations;
+  unsigned long long position = magic.size();
+  while(position < buffer.size())
+  {
+    auto group_name = parse_string(buffer, position);
+    auto test_name = parse_string(buffer, position);
+    auto const duration_us = parse_varint(buffer, position);
+    if(
+      !group_name.has_value() || !test_name.has_value() ||
+      !duration_us.has_value())
+    {
+      break;
+    }
+
+    durations[{std::move(group_name.value()), std::move(test_name.value())}] =
+      duration_us.value();
+  }
+
+  return durations;
+}
+
+auto write_all(int const fd, std::vector<unsigned char> const &buffer) -> bool
+{
+  unsigned long long written = 0;
+  while(written < buffer.size())
+  {
+    auto const result =
+      ::write(fd, buffer.data() + written, buffer.size() - written);
+    if(result < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+
+      return false;
+    }
+
+    written += static_cast<unsigned long long>(result);
+  }
+
+  return true;
+}
+
+} // namespace
+
+namespace waypoint::internal
+{
+
+auto read_timing_database(std::string const &path) -> TestDurations
+{
+  std::ifstream file{path, std::ios::binary};
+  if(!file)
+  {
+    return {};
+  }
+
+  std::vector<unsigned char> const buffer{
+    std::istreambuf_iterator<char>{file},
+    std::istreambuf_iterator<char>{}};
+
+  return decode(buffer);
+}
+
+void update_timing_database(
+  std::string const &path,
+  TestDurations const &durations)
+{
+  // The database itself is replaced by rename, so it cannot be locked
+  auto const lock_path = path + ".lock";
+  auto const raw_lock =
+    ::open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(raw_lock < 0)
+  {
+    return;
+  }
+
+  auto locked = ::flock(raw_lock, LOCK_EX);
+  while(locked != 0 && errno == EINTR)
+  {
+    locked = ::flock(raw_lock, LOCK_EX);
+  }
+
+  if(locked == 0)
+  {
+    auto merged = read_timing_database(path);
+    for(auto const &[key, duration_us] : durations)
+    {
+      merged[key] = duration_us;
+    }
+
+    auto const temporary_path = path + "." + std::to_string(::getpid());
+    auto const raw_temporary = ::open(
+      temporary_path.c_str(),
+      O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+      0644);
+    if(raw_temporary >= 0)
+    {
+      auto const written = write_all(raw_temporary, encode(merged)) &&
+        ::fsync(raw_temporary) == 0;
+      ::close(raw_temporary);
+
+      if(!written || std::rename(temporary_path.c_str(), path.c_str()) != 0)
+      {
+        std::remove(temporary_path.c_str());
+      }
+    }
+  }
+
+  // Closing the lock file releases the lock
+  ::close(raw_lock);
+}
+
+} // namespace waypoint::internal
@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -33,4 +33,10 @@ Function<void(Context const &)>::callable_interface::~callable_interface() =
 Function<void(Context const &)>::callable_interface::callable_interface() =
   default;
 
+GroupFixtureFactory::~GroupFixtureFactory() = default;
+GroupFixtureFactory::GroupFixtureFactory() = default;
+
+SharedDataFactory::~SharedDataFactory() = default;
+SharedDataFactory::SharedDataFactory() = default;
+
 } // namespace waypoint::internal
@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -7,55 +7,151 @@
 #include "types.hpp"
 #include "waypoint.hpp"
 
+#include "assert/assert.hpp"
 #include "process/process.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <format>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <random>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
-namespace waypoint::internal
+namespace
 {
 
-AssertionOutcome_impl::AssertionOutcome_impl()
-  : test_outcome_{},
-    passed_{},
-    index_{}
+char const *const WAYPOINT_WORKERS_ENV_NAME = "WAYPOINT_WORKERS";
+char const *const WAYPOINT_PIPELINE_DEPTH_ENV_NAME = "WAYPOINT_PIPELINE_DEPTH";
+char const *const WAYPOINT_FLUSH_INTERVAL_MS_ENV_NAME =
+  "WAYPOINT_FLUSH_INTERVAL_MS";
+char const *const WAYPOINT_TRANSPORT_ENV_NAME = "WAYPOINT_TRANSPORT";
+char const *const WAYPOINT_SPAWN_ENV_NAME = "WAYPOINT_SPAWN";
+char const *const WAYPOINT_ISOLATION_ENV_NAME = "WAYPOINT_ISOLATION";
+char const *const WAYPOINT_TIMING_DATABASE_ENV_NAME =
+  "WAYPOINT_TIMING_DATABASE";
+char const *const WAYPOINT_SHARD_INDEX_ENV_NAME = "WAYPOINT_SHARD_INDEX";
+char const *const WAYPOINT_SHARD_COUNT_ENV_NAME = "WAYPOINT_SHARD_COUNT";
+char const *const WAYPOINT_MAX_FAILURES_ENV_NAME = "WAYPOINT_MAX_FAILURES";
+
+auto get_env_number(char const *const var_name)
+  -> std::optional<unsigned long long>
 {
+  auto const *const var_value = std::getenv(var_name);
+  if(var_value == nullptr)
+  {
+    return std::nullopt;
+  }
+
+  std::string_view const str{var_value};
+
+  unsigned long long value = 0;
+  auto const [ptr, ec] =
+    std::from_chars(str.data(), str.data() + str.size(), value);
+  if(ec != std::errc{} || ptr != str.data() + str.size())
+  {
+    return std::nullopt;
+  }
+
+  return {value};
 }
 
-void AssertionOutcome_impl::initialize(
-  TestOutcome const *const test_outcome,
-  std::optional<std::string> message,
-  bool const passed,
-  unsigned long long const index)
+auto get_env_transport() -> waypoint::RunConfig::Transport
 {
-  this->test_outcome_ = test_outcome;
-  this->message_ = std::move(message);
-  this->passed_ = passed;
-  this->index_ = index;
+  auto const *const var_value = std::getenv(WAYPOINT_TRANSPORT_ENV_NAME);
+  if(
+    var_value != nullptr &&
+    std::string_view{var_value} == std::string_view{"shared_memory"})
+  {
+    return waypoint::RunConfig::Transport::SharedMemory;
+  }
+
+  return waypoint::RunConfig::Transport::Pipe;
 }
 
-auto AssertionOutcome_impl::group_name() const -> char const *
+auto get_env_spawn() -> waypoint::RunConfig::Spawn
 {
-  return this->test_outcome_->group_name();
+  auto const *const var_value = std::getenv(WAYPOINT_SPAWN_ENV_NAME);
+  if(
+    var_value != nullptr &&
+    std::string_view{var_value} == std::string_view{"zygote"})
+  {
+    return waypoint::RunConfig::Spawn::Zygote;
+  }
+
+  return waypoint::RunConfig::Spawn::Exec;
 }
 
-auto AssertionOutcome_impl::test_name() const -> char const *
+auto get_env_isolation() -> waypoint::RunConfig::Isolation
 {
-  return this->test_outcome_->test_name();
+  auto const *const var_value = std::getenv(WAYPOINT_ISOLATION_ENV_NAME);
+  if(
+    var_value != nullptr &&
+    std::string_view{var_value} == std::string_view{"per_test"})
+  {
+    return waypoint::RunConfig::Isolation::PerTest;
+  }
+
+  return waypoint::RunConfig::Isolation::SharedChild;
 }
 
-auto AssertionOutcome_impl::message() const
-  -> std::optional<std::string> const &
+// Returns the first shard variable which is set but is not a number, as
+// name=value
+auto get_env_malformed_shard() -> std::optional<std::string>
+{
+  for(auto const *const var_name :
+      {WAYPOINT_SHARD_INDEX_ENV_NAME, WAYPOINT_SHARD_COUNT_ENV_NAME})
+  {
+    auto const *const var_value = std::getenv(var_name);
+    if(var_value != nullptr && !get_env_number(var_name).has_value())
+    {
+      return std::format("{}={}", var_name, var_value);
+    }
+  }
+
+  return std::nullopt;
+}
+
+auto get_env_string(char const *const var_name) -> std::optional<std::string>
+{
+  auto const *const var_value = std::getenv(var_name);
+  if(var_value == nullptr)
+  {
+    return std::nullopt;
+  }
+
+  return {var_value};
+}
+
+} // namespace
+
+namespace waypoint::internal
+{
+
+AssertionOutcome_impl::AssertionOutcome_impl(
+  bool const passed,
+  AssertionIndex const index,
+  char const *const maybe_message)
+  : message_{maybe_message},
+    index_{index},
+    passed_{passed}
+{
+}
+
+auto AssertionOutcome_impl::message() const -> char const *
 {
   return this->message_;
 }
@@ -65,88 +161,202 @@ auto AssertionOutcome_impl::passed() const -> bool
   return this->passed_;
 }
 
-auto AssertionOutcome_impl::index() const -> unsigned long long
+auto AssertionOutcome_impl::index() const -> AssertionIndex
 {
   return this->index_;
 }
 
+AssertionLog::AssertionLog()
+  : has_failures_{false},
+    is_passing_kept_{true}
+{
+}
+
+void AssertionLog::keep_passing_assertions(bool const is_kept)
+{
+  this->is_passing_kept_ = is_kept;
+}
+
+void AssertionLog::add_test()
+{
+  this->tests_.emplace_back(&this->arena_);
+  this->passing_counts_.push_back(0);
+}
+
+void AssertionLog::append(
+  TestId const test_id,
+  bool const passed,
+  AssertionIndex const index,
+  std::optional<std::string> const &maybe_message)
+{
+  if(passed)
+  {
+    ++this->passing_counts_[test_id];
+    if(!this->is_passing_kept_)
+    {
+      return;
+    }
+  }
+
+  char const *message = nullptr;
+  if(maybe_message.has_value())
+  {
+    auto *const destination = static_cast<char *>(
+      this->arena_.allocate(maybe_message->size() + 1, alignof(char)));
+    std::ranges::copy(*maybe_message, destination);
+    destination[maybe_message->size()] = '\0';
+    message = destination;
+  }
+
+  auto &assertions = this->tests_[test_id];
+  // Assertions arrive in index order unless a test was interrupted
+  // mid-transmission, so this is almost always an append
+  auto const position = std::ranges::upper_bound(
+    assertions,
+    index,
+    std::less{},
+    &AssertionOutcome_impl::index);
+  assertions.emplace(position, passed, index, message);
+
+  this->has_failures_ = this->has_failures_ || !passed;
+}
+
+auto AssertionLog::assertions(TestId const test_id) const
+  -> std::span<AssertionOutcome_impl const>
+{
+  return this->tests_[test_id];
+}
+
+auto AssertionLog::has_failures() const -> bool
+{
+  return this->has_failures_;
+}
+
+auto AssertionLog::has_failures(TestId const test_id) const -> bool
+{
+  return !std::ranges::all_of(
+    this->tests_[test_id],
+    &AssertionOutcome_impl::passed);
+}
+
+auto AssertionLog::passing_count(TestId const test_id) const
+  -> unsigned long long
+{
+  return this->passing_counts_[test_id];
+}
+
+TestOutcome_impl::~TestOutcome_impl()
+{
+  std::destroy_n(this->assertion_outcomes_, this->assertion_count_);
+  std::allocator<AssertionOutcome>{}.deallocate(
+    this->assertion_outcomes_,
+    this->assertion_count_);
+}
+
 TestOutcome_impl::TestOutcome_impl()
-  : test_index_{},
-    disabled_{},
-    status_{TestOutcome::Status::NotRun}
+  : summary_{nullptr},
+    assertion_outcomes_{nullptr},
+    assertion_count_{0}
 {
 }
 
 void TestOutcome_impl::initialize(
-  std::vector<std::unique_ptr<AssertionOutcome>> assertion_outcomes,
-  std::string group_name,
-  std::string test_name,
-  unsigned long long const index,
-  bool const disabled,
-  TestOutcome::Status const status,
-  std::optional<unsigned long long> const maybe_exit_status)
-{
-  this->assertion_outcomes_ = std::move(assertion_outcomes);
-  this->group_name_ = std::move(group_name);
-  this->test_name_ = std::move(test_name);
-  this->test_index_ = index;
-  this->disabled_ = disabled;
-  this->status_ = status;
-  this->exit_status_ = maybe_exit_status;
+  TestOutcome const *const test_outcome,
+  TestSummary const *const summary,
+  std::span<AssertionOutcome_impl const> const assertions)
+{
+  this->summary_ = summary;
+  this->assertion_outcomes_ =
+    std::allocator<AssertionOutcome>{}.allocate(assertions.size());
+  this->assertion_count_ = assertions.size();
+  for(unsigned long long i = 0; i < assertions.size(); ++i)
+  {
+    ::new(static_cast<void *>(this->assertion_outcomes_ + i))
+      AssertionOutcome{test_outcome, &assertions[i]};
+
+    if(!assertions[i].passed())
+    {
+      this->failing_assertion_indices_.push_back(i);
+    }
+  }
 }
 
-auto TestOutcome_impl::get_test_name() const -> std::string const &
+auto TestOutcome_impl::get_test_name() const -> std::string_view
 {
-  return this->test_name_;
+  return this->summary_->test_name;
 }
 
-auto TestOutcome_impl::get_group_name() const -> std::string const &
+auto TestOutcome_impl::get_group_name() const -> std::string_view
 {
-  return this->group_name_;
+  return this->summary_->group_name;
 }
 
 auto TestOutcome_impl::get_assertion_count() const -> unsigned long long
 {
-  return this->assertion_outcomes_.size();
+  return this->assertion_count_;
 }
 
 auto TestOutcome_impl::get_assertion_outcome(
   unsigned long long const index) const -> AssertionOutcome const &
 {
-  return *this->assertion_outcomes_[index];
+  return this->assertion_outcomes_[index];
+}
+
+auto TestOutcome_impl::get_failing_assertion_count() const
+  -> unsigned long long
+{
+  return this->failing_assertion_indices_.size();
+}
+
+auto TestOutcome_impl::get_failing_assertion_outcome(
+  unsigned long long const index) const -> AssertionOutcome const &
+{
+  return this->assertion_outcomes_[this->failing_assertion_indices_[index]];
+}
+
+auto TestOutcome_impl::get_passing_assertion_count() const
+  -> unsigned long long
+{
+  return this->summary_->passing_assertion_count;
 }
 
 auto TestOutcome_impl::get_index() const -> unsigned long long
 {
-  return this->test_index_;
+  return this->summary_->test_index;
 }
 
 auto TestOutcome_impl::disabled() const -> bool
 {
-  return this->disabled_;
+  return this->summary_->disabled;
 }
 
 auto TestOutcome_impl::status() const -> TestOutcome::Status
 {
-  return this->status_;
+  return this->summary_->status;
 }
 
 auto TestOutcome_impl::exit_status() const
   -> std::optional<unsigned long long> const &
 {
-  return this->exit_status_;
+  return this->summary_->exit_status;
 }
 
 TestRecord::TestRecord(
   TestAssembly assembly,
   TestId const test_id,
   unsigned long long const timeout_ms,
-  bool const disabled)
+  bool const disabled,
+  bool const isolated,
+  bool const thread_unsafe)
   : test_assembly_(std::move(assembly)),
     test_id_{test_id},
     disabled_{disabled},
     status_{TestRecord::Status::NotRun},
-    timeout_ms_{timeout_ms}
+    timeout_ms_{timeout_ms},
+    isolated_{isolated},
+    duration_us_{},
+    in_shard_{true},
+    thread_unsafe_{thread_unsafe}
 {
 }
 
@@ -175,6 +385,41 @@ auto TestRecord::timeout_ms() const -> unsigned long long
   return this->timeout_ms_;
 }
 
+auto TestRecord::isolated() const -> bool
+{
+  return this->isolated_;
+}
+
+void TestRecord::isolate()
+{
+  this->isolated_ = true;
+}
+
+auto TestRecord::thread_unsafe() const -> bool
+{
+  return this->thread_unsafe_;
+}
+
+auto TestRecord::duration_us() const -> std::optional<unsigned long long>
+{
+  return this->duration_us_;
+}
+
+void TestRecord::set_duration_us(unsigned long long const duration_us)
+{
+  this->duration_us_ = duration_us;
+}
+
+auto TestRecord::in_shard() const -> bool
+{
+  return this->in_shard_;
+}
+
+void TestRecord::exclude_from_shard()
+{
+  this->in_shard_ = false;
+}
+
 void TestRecord::mark_as_run()
 {
   this->status_ = TestRecord::Status::Complete;
@@ -190,6 +435,11 @@ void TestRecord::mark_as_timed_out()
   this->status_ = TestRecord::Status::Timeout;
 }
 
+void TestRecord::mark_as_not_run()
+{
+  this->status_ = TestRecord::Status::NotRun;
+}
+
 AssertionRecord::AssertionRecord(
   bool const condition,
   AssertionIndex const index,
@@ -269,39 +519,50 @@ void Test_impl::mark_complete()
 ContextInProcess_impl::ContextInProcess_impl()
   : test_run_{},
     test_id_{},
-    assertion_index_{}
+    assertion_index_{},
+    assertion_buffer_{}
 {
 }
 
 void ContextInProcess_impl::initialize(
   TestRun const &test_run,
-  TestId const test_id)
+  TestId const test_id,
+  AssertionBuffer *const assertion_buffer)
 {
   this->test_run_ = &test_run;
   this->test_id_ = test_id;
   this->assertion_index_ = 0;
+  this->assertion_buffer_ = assertion_buffer;
 }
 
-auto ContextInProcess_impl::get_test_run() const -> TestRun const &
+void ContextInProcess_impl::register_assertion(
+  bool const condition,
+  std::optional<std::string> maybe_message)
 {
-  return *test_run_;
-}
+  auto const index = this->assertion_index_++;
 
-auto ContextInProcess_impl::generate_assertion_index() -> AssertionIndex
-{
-  return assertion_index_++;
-}
+  if(this->assertion_buffer_ != nullptr)
+  {
+    this->assertion_buffer_->emplace_back(
+      this->test_id_,
+      AssertionRecord{condition, index, std::move(maybe_message)});
 
-auto ContextInProcess_impl::test_id() const -> TestId
-{
-  return this->test_id_;
+    return;
+  }
+
+  get_impl(*this->test_run_)
+    .register_assertion(
+      condition,
+      this->test_id_,
+      index,
+      std::move(maybe_message));
 }
 
 ContextChildProcess_impl::ContextChildProcess_impl()
   : test_run_{},
     test_id_{},
     assertion_index_{},
-    response_write_pipe_{},
+    response_writer_{},
     transmission_mutex_{}
 {
 }
@@ -309,13 +570,13 @@ ContextChildProcess_impl::ContextChildProcess_impl()
 void ContextChildProcess_impl::initialize(
   TestRun const &test_run,
   TestId const test_id,
-  InputPipeEnd const &response_write_pipe,
+  ResponseWriter &response_writer,
   std::mutex &transmission_mutex)
 {
   this->test_run_ = &test_run;
   this->test_id_ = test_id;
   this->assertion_index_ = 0;
-  this->response_write_pipe_ = &response_write_pipe;
+  this->response_writer_ = &response_writer;
   this->transmission_mutex_ = &transmission_mutex;
 }
 
@@ -334,10 +595,10 @@ auto ContextChildProcess_impl::test_id() const -> TestId
   return this->test_id_;
 }
 
-auto ContextChildProcess_impl::response_write_pipe() const
-  -> InputPipeEnd const *
+auto ContextChildProcess_impl::response_writer() const
+  -> ResponseWriter *
 {
-  return this->response_write_pipe_;
+  return this->response_writer_;
 }
 
 auto ContextChildProcess_impl::transmission_mutex() const -> std::mutex *
@@ -345,10 +606,245 @@ auto ContextChildProcess_impl::transmission_mutex() const -> std::mutex *
   return this->transmission_mutex_;
 }
 
+RunConfig_impl::RunConfig_impl()
+  : worker_count_{get_env_number(WAYPOINT_WORKERS_ENV_NAME).value_or(1)},
+    pipeline_depth_{
+      get_env_number(WAYPOINT_PIPELINE_DEPTH_ENV_NAME).value_or(1)},
+    flush_interval_ms_{
+      get_env_number(WAYPOINT_FLUSH_INTERVAL_MS_ENV_NAME).value_or(0)},
+    transport_{get_env_transport()},
+    spawn_{get_env_spawn()},
+    isolation_{get_env_isolation()},
+    timing_database_{get_env_string(WAYPOINT_TIMING_DATABASE_ENV_NAME)},
+    shard_index_{get_env_number(WAYPOINT_SHARD_INDEX_ENV_NAME).value_or(0)},
+    shard_count_{get_env_number(WAYPOINT_SHARD_COUNT_ENV_NAME).value_or(1)},
+    malformed_shard_variable_{get_env_malformed_shard()},
+    max_failures_{get_env_number(WAYPOINT_MAX_FAILURES_ENV_NAME).value_or(0)},
+    result_sink_{nullptr}
+{
+}
+
+void RunConfig_impl::set_worker_count(unsigned long long const count)
+{
+  this->worker_count_ = count;
+}
+
+auto RunConfig_impl::worker_count() const -> unsigned long long
+{
+  if(this->worker_count_ == 0)
+  {
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  return this->worker_count_;
+}
+
+void RunConfig_impl::set_pipeline_depth(unsigned long long const depth)
+{
+  this->pipeline_depth_ = depth;
+}
+
+auto RunConfig_impl::pipeline_depth() const -> unsigned long long
+{
+  return std::max(1ULL, this->pipeline_depth_);
+}
+
+void RunConfig_impl::set_flush_interval_ms(
+  unsigned long long const interval_ms)
+{
+  this->flush_interval_ms_ = interval_ms;
+}
+
+auto RunConfig_impl::flush_interval_ms() const -> unsigned long long
+{
+  return this->flush_interval_ms_;
+}
+
+void RunConfig_impl::set_transport(RunConfig::Transport const transport)
+{
+  this->transport_ = transport;
+}
+
+auto RunConfig_impl::transport() const -> RunConfig::Transport
+{
+  return this->transport_;
+}
+
+void RunConfig_impl::set_spawn(RunConfig::Spawn const spawn)
+{
+  this->spawn_ = spawn;
+}
+
+auto RunConfig_impl::spawn() const -> RunConfig::Spawn
+{
+  return this->spawn_;
+}
+
+void RunConfig_impl::set_isolation(RunConfig::Isolation const isolation)
+{
+  this->isolation_ = isolation;
+}
+
+auto RunConfig_impl::isolation() const -> RunConfig::Isolation
+{
+  return this->isolation_;
+}
+
+void RunConfig_impl::set_timing_database(std::string path)
+{
+  this->timing_database_ = std::move(path);
+}
+
+auto RunConfig_impl::timing_database() const
+  -> std::optional<std::string> const &
+{
+  return this->timing_database_;
+}
+
+void RunConfig_impl::set_shard(
+  unsigned long long const index,
+  unsigned long long const count)
+{
+  this->shard_index_ = index;
+  this->shard_count_ = count;
+  this->malformed_shard_variable_.reset();
+}
+
+auto RunConfig_impl::shard_index() const -> unsigned long long
+{
+  return this->shard_index_;
+}
+
+auto RunConfig_impl::shard_count() const -> unsigned long long
+{
+  return this->shard_count_;
+}
+
+auto RunConfig_impl::malformed_shard_variable() const
+  -> std::optional<std::string> const &
+{
+  return this->malformed_shard_variable_;
+}
+
+void RunConfig_impl::set_max_failures(unsigned long long const count)
+{
+  this->max_failures_ = count;
+}
+
+// Zero means no limit
+auto RunConfig_impl::max_failures() const -> unsigned long long
+{
+  return this->max_failures_;
+}
+
+void RunConfig_impl::set_result_sink(ResultSink *const sink)
+{
+  this->result_sink_ = sink;
+}
+
+auto RunConfig_impl::result_sink() const -> ResultSink *
+{
+  return this->result_sink_;
+}
+
+GroupFixtureRecord::~GroupFixtureRecord()
+{
+  this->tear_down();
+}
+
+GroupFixtureRecord::GroupFixtureRecord(
+  GroupId const group_id,
+  std::unique_ptr<GroupFixtureFactory> factory,
+  bool const is_snapshot)
+  : group_id_{group_id},
+    factory_{std::move(factory)},
+    is_snapshot_{is_snapshot},
+    value_{nullptr}
+{
+}
+
+auto GroupFixtureRecord::group_id() const -> GroupId
+{
+  return this->group_id_;
+}
+
+auto GroupFixtureRecord::is_snapshot() const -> bool
+{
+  return this->is_snapshot_;
+}
+
+auto GroupFixtureRecord::is_built() -> bool
+{
+  std::lock_guard const lock{this->mutex_};
+
+  return this->value_ != nullptr;
+}
+
+// Tests running on several threads may ask for it at the same time
+auto GroupFixtureRecord::get() -> void *
+{
+  std::lock_guard const lock{this->mutex_};
+  if(this->value_ == nullptr)
+  {
+    this->value_ = this->factory_->create();
+  }
+
+  return this->value_;
+}
+
+void GroupFixtureRecord::tear_down()
+{
+  std::lock_guard const lock{this->mutex_};
+  if(this->value_ != nullptr)
+  {
+    this->factory_->destroy(this->value_);
+    this->value_ = nullptr;
+  }
+}
+
+TestRun_impl::~TestRun_impl() = default;
+
+NameTable::NameTable()
+  : chunk_capacity_{0},
+    chunk_used_{0}
+{
+}
+
+auto NameTable::intern(std::string_view const name) -> std::string_view
+{
+  auto const it = this->names_.find(name);
+  if(it != this->names_.end())
+  {
+    return *it;
+  }
+
+  // Names are only ever appended, so earlier views are never moved
+  constexpr unsigned long long chunk_size = 65'536;
+
+  unsigned long long const size = name.size() + 1;
+  if(this->chunk_capacity_ - this->chunk_used_ < size)
+  {
+    this->chunk_capacity_ = std::max(chunk_size, size);
+    this->chunk_used_ = 0;
+    this->chunks_.push_back(
+      std::make_unique_for_overwrite<char[]>(this->chunk_capacity_));
+  }
+
+  auto *const destination = this->chunks_.back().get() + this->chunk_used_;
+  std::ranges::copy(name, destination);
+  destination[name.size()] = '\0';
+  this->chunk_used_ += size;
+
+  return *this->names_.emplace(destination, name.size()).first;
+}
+
 TestRun_impl::TestRun_impl()
   : test_run_{nullptr},
     group_id_counter_{0},
-    test_id_counter_{0}
+    test_id_counter_{0},
+    names_{std::make_shared<NameTable>()},
+    assertion_log_{std::make_shared<AssertionLog>()},
+    result_sink_{nullptr}
 {
 }
 
@@ -372,7 +868,7 @@ auto TestRun_impl::make_test(TestId const test_id) const -> Test
 
 auto TestRun_impl::get_group_id(TestId const id) const -> GroupId
 {
-  return this->test_id2group_id_.at(id);
+  return this->test_group_ids_[id];
 }
 
 auto TestRun_impl::get_group_id(Group const &group) const -> GroupId
@@ -380,27 +876,32 @@ auto TestRun_impl::get_group_id(Group const &group) const -> GroupId
   return group.impl_->get_id();
 }
 
-auto TestRun_impl::get_group_name(GroupId const id) const -> std::string
+auto TestRun_impl::get_group_name(GroupId const id) const -> std::string_view
 {
-  return this->group_id2group_name_.at(id);
+  return this->group_names_[id];
 }
 
-auto TestRun_impl::get_test_name(TestId const id) const -> std::string
+auto TestRun_impl::get_test_name(TestId const id) const -> std::string_view
 {
-  return this->test_id2test_name_.at(id);
+  return this->test_names_[id];
+}
+
+auto TestRun_impl::names() const -> std::shared_ptr<NameTable const>
+{
+  return this->names_;
 }
 
 void TestRun_impl::set_test_index(
   TestId const test_id,
   unsigned long long const index)
 {
-  this->test_id2test_index_[test_id] = index;
+  this->test_indices_[test_id] = index;
 }
 
 auto TestRun_impl::get_test_index(TestId const test_id) const
   -> unsigned long long
 {
-  return this->test_id2test_index_.at(test_id);
+  return this->test_indices_[test_id];
 }
 
 auto TestRun_impl::test_count() const -> unsigned long long
@@ -408,54 +909,12 @@ auto TestRun_impl::test_count() const -> unsigned long long
   return test_id_counter_;
 }
 
-auto TestRun_impl::make_test_outcome(TestId const test_id) const noexcept
-  -> std::unique_ptr<TestOutcome>
+auto TestRun_impl::summarize_test(TestId const test_id) const -> TestSummary
 {
-  std::vector<std::unique_ptr<AssertionOutcome>> assertion_outcomes;
-
-  auto const assertions = std::invoke(
-    [this, test_id]() -> std::vector<AssertionRecord>
-    {
-      auto const &passing_assertions = this->get_passing_assertions(test_id);
-      auto const &failing_assertions = this->get_failing_assertions(test_id);
-
-      auto assertions2 =
-        std::ranges::views::join(
-          std::vector{passing_assertions, failing_assertions}) |
-        std::ranges::to<std::vector<AssertionRecord>>();
-
-      std::ranges::sort(
-        assertions2,
-        [](auto const &a, auto const &b)
-        {
-          return a.index() < b.index();
-        });
-
-      return assertions2;
-    });
-
-  auto *const impl = new TestOutcome_impl{};
-  auto test_outcome = std::unique_ptr<TestOutcome>(new TestOutcome{impl});
-
-  for(auto const &assertion : assertions)
-  {
-    auto const maybe_message = assertion.message();
-    auto *const assertion_impl = new AssertionOutcome_impl{};
-
-    assertion_impl->initialize(
-      test_outcome.get(),
-      maybe_message,
-      assertion.passed(),
-      assertion.index());
-
-    assertion_outcomes.emplace_back(
-      std::unique_ptr<AssertionOutcome>(new AssertionOutcome{assertion_impl}));
-  }
-
   auto const &test_record = this->test_records_[test_id];
 
   auto const status = std::invoke(
-    [&test_record, &assertion_outcomes]()
+    [this, test_id, &test_record]()
     {
       if(test_record.status() == TestRecord::Status::NotRun)
       {
@@ -472,47 +931,39 @@ auto TestRun_impl::make_test_outcome(TestId const test_id) const noexcept
         return TestOutcome::Status::Timeout;
       }
 
-      auto const it = std::ranges::find_if(
-        assertion_outcomes,
-        [](auto const &assertion_outcome)
-        {
-          return !assertion_outcome->passed();
-        });
-
-      return it == assertion_outcomes.end() ? TestOutcome::Status::Success
-                                            : TestOutcome::Status::Failure;
+      return this->assertion_log_->has_failures(test_id)
+               ? TestOutcome::Status::Failure
+               : TestOutcome::Status::Success;
     });
 
-  impl->initialize(
-    std::move(assertion_outcomes),
+  return TestSummary{
+    test_id,
     this->get_group_name(this->get_group_id(test_id)),
     this->get_test_name(test_id),
     this->get_test_index(test_id),
-    this->is_disabled(test_id),
+    this->assertion_log_->passing_count(test_id),
+    this->get_crashed_exit_status(test_id),
     status,
-    this->get_crashed_exit_status(test_id));
-
-  return test_outcome;
+    this->is_disabled(test_id)};
 }
 
 auto TestRun_impl::register_test(
   GroupId const group_id,
   TestName const &test_name) -> TestId
 {
-  auto &test_names = test_names_per_group_[group_id];
-  if(test_names.contains(test_name))
+  auto const name = this->names_->intern(test_name);
+  if(!this->test_names_per_group_[group_id].insert(name.data()).second)
   {
-    auto const &group_name = this->group_id2group_name_[group_id];
-    this->report_duplicate_test_name(group_name, test_name);
+    this->report_duplicate_test_name(this->group_names_[group_id], name);
   }
 
-  test_names.insert(test_name);
-
   auto const test_id = test_id_counter_++;
 
-  test_id2group_id_[test_id] = group_id;
-
-  this->test_id2test_name_[test_id] = test_name;
+  this->test_names_.push_back(name);
+  this->test_group_ids_.push_back(group_id);
+  this->test_indices_.push_back(0);
+  this->assertion_log_->add_test();
+  this->crashed_exit_statuses_.emplace_back();
 
   return test_id;
 }
@@ -520,7 +971,8 @@ auto TestRun_impl::register_test(
 auto TestRun_impl::register_group(GroupName const &group_name) -> GroupId
 {
   auto const group_id = group_id_counter_++;
-  group_id2group_name_[group_id] = group_name;
+  this->group_names_.push_back(this->names_->intern(group_name));
+  this->test_names_per_group_.emplace_back();
 
   return group_id;
 }
@@ -531,8 +983,8 @@ void TestRun_impl::report_error(ErrorType type, std::string const &message)
 }
 
 void TestRun_impl::report_duplicate_test_name(
-  GroupName const &group_name,
-  TestName const &test_name)
+  std::string_view const group_name,
+  std::string_view const test_name)
 {
   this->report_error(
     ErrorType::Init_DuplicateTestInGroup,
@@ -557,46 +1009,54 @@ void TestRun_impl::report_incomplete_test(TestId const test_id)
       group_name));
 }
 
-auto TestRun_impl::get_passing_assertions(TestId const test_id) const
-  -> std::vector<AssertionRecord>
+void TestRun_impl::report_invalid_shard(
+  unsigned long long const shard_index,
+  unsigned long long const shard_count)
 {
-  if(this->passing_assertions_.contains(test_id))
-  {
-    return this->passing_assertions_.at(test_id);
-  }
-
-  return {};
+  this->report_error(
+    ErrorType::Config_InvalidShard,
+    std::format(
+      "Shard index {} is out of range for {} shards",
+      shard_index,
+      shard_count));
 }
 
-auto TestRun_impl::get_failing_assertions(TestId const test_id) const
-  -> std::vector<AssertionRecord>
+void TestRun_impl::report_malformed_shard(std::string const &variable)
 {
-  if(this->failing_assertions_.contains(test_id))
-  {
-    return this->failing_assertions_.at(test_id);
-  }
+  this->report_error(
+    ErrorType::Config_InvalidShard,
+    std::format("Shard variable {} is not a number", variable));
+}
 
-  return {};
+auto TestRun_impl::assertion_log() const -> std::shared_ptr<AssertionLog const>
+{
+  return this->assertion_log_;
 }
 
 auto TestRun_impl::has_failing_assertions() const -> bool
 {
-  return !this->failing_assertions_.empty();
+  return this->assertion_log_->has_failures();
+}
+
+auto TestRun_impl::has_failing_assertions(TestId const test_id) const -> bool
+{
+  return this->assertion_log_->has_failures(test_id);
 }
 
-auto TestRun_impl::make_in_process_context(TestId const test_id) const
-  -> std::unique_ptr<Context>
+auto TestRun_impl::make_in_process_context(
+  TestId const test_id,
+  AssertionBuffer *const assertion_buffer) const -> std::unique_ptr<Context>
 {
   auto *impl = new ContextInProcess_impl{};
 
-  impl->initialize(*this->test_run_, test_id);
+  impl->initialize(*this->test_run_, test_id, assertion_buffer);
 
   return std::unique_ptr<ContextInProcess>(new ContextInProcess{impl});
 }
 
 auto TestRun_impl::make_child_process_context(
   TestId const test_id,
-  InputPipeEnd const &response_write_pipe,
+  ResponseWriter &response_writer,
   std::mutex &transmission_mutex) const -> std::unique_ptr<Context>
 {
   auto *impl = new ContextChildProcess_impl{};
@@ -604,7 +1064,7 @@ auto TestRun_impl::make_child_process_context(
   impl->initialize(
     *this->test_run_,
     test_id,
-    response_write_pipe,
+    response_writer,
     transmission_mutex);
 
   return std::unique_ptr<ContextChildProcess>(new ContextChildProcess{impl});
@@ -680,22 +1140,282 @@ auto TestRun_impl::is_disabled(TestId const test_id) const -> bool
   return record.disabled();
 }
 
+// Partitions by position in the shuffled order, which is the same on
+// every machine running the same binary
+void TestRun_impl::select_shard(
+  unsigned long long const shard_index,
+  unsigned long long const shard_count)
+{
+  if(shard_index >= shard_count)
+  {
+    this->report_invalid_shard(shard_index, shard_count);
+
+    return;
+  }
+
+  auto const &ptrs = this->shuffled_test_record_ptrs_;
+  for(unsigned long long i = 0; i < ptrs.size(); ++i)
+  {
+    if(i % shard_count != shard_index)
+    {
+      ptrs[i]->exclude_from_shard();
+    }
+  }
+}
+
+auto TestRun_impl::is_in_shard(TestId const test_id) const -> bool
+{
+  auto const &record = this->test_records_[test_id];
+
+  return record.in_shard();
+}
+
+auto TestRun_impl::register_group_fixture(
+  GroupId const group_id,
+  std::unique_ptr<GroupFixtureFactory> factory,
+  bool const is_snapshot) -> unsigned long long
+{
+  this->group_fixtures_.push_back(std::make_unique<GroupFixtureRecord>(
+    group_id,
+    std::move(factory),
+    is_snapshot));
+
+  return this->group_fixtures_.size() - 1;
+}
+
+auto TestRun_impl::get_group_fixture(unsigned long long const index) const
+  -> void *
+{
+  return this->group_fixtures_.at(index)->get();
+}
+
+auto TestRun_impl::has_group_fixtures(GroupId const group_id) const -> bool
+{
+  return std::ranges::any_of(
+    this->group_fixtures_,
+    [group_id](auto const &fixture)
+    {
+      return fixture->group_id() == group_id;
+    });
+}
+
+auto TestRun_impl::has_snapshot_fixtures(GroupId const group_id) const -> bool
+{
+  return std::ranges::any_of(
+    this->group_fixtures_,
+    [group_id](auto const &fixture)
+    {
+      return fixture->group_id() == group_id && fixture->is_snapshot();
+    });
+}
+
+auto TestRun_impl::has_unbuilt_group_fixtures(GroupId const group_id) const
+  -> bool
+{
+  return std::ranges::any_of(
+    this->group_fixtures_,
+    [group_id](auto const &fixture)
+    {
+      return fixture->group_id() == group_id && !fixture->is_built();
+    });
+}
+
+void TestRun_impl::build_group_fixtures(GroupId const group_id) const
+{
+  for(auto const &fixture : this->group_fixtures_)
+  {
+    if(fixture->group_id() == group_id)
+    {
+      [[maybe_unused]]
+      auto const *const value = fixture->get();
+    }
+  }
+}
+
+void TestRun_impl::tear_down_group_fixtures() const
+{
+  for(auto const &fixture : this->group_fixtures_)
+  {
+    fixture->tear_down();
+  }
+}
+
+void TestRun_impl::tear_down_snapshot_fixtures(GroupId const group_id) const
+{
+  for(auto const &fixture : this->group_fixtures_)
+  {
+    if(fixture->group_id() == group_id && fixture->is_snapshot())
+    {
+      fixture->tear_down();
+    }
+  }
+}
+
+namespace
+{
+
+auto align_shared_data(unsigned long long const offset) -> unsigned long long
+{
+  constexpr auto alignment = SHARED_DATA_ALIGNMENT;
+
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+// The region starts with the offset and size of every value, so
+// that workers read its layout instead of computing sizes again,
+// which may only be known in the process starting the run
+struct SharedDataEntry
+{
+  unsigned long long offset;
+  unsigned long long size;
+};
+
+auto shared_data_entry(
+  ReadOnlyRegion const &region,
+  unsigned long long const index) -> SharedDataEntry
+{
+  SharedDataEntry entry{0, 0};
+  std::memcpy(
+    &entry,
+    region.data() + (index * sizeof(SharedDataEntry)),
+    sizeof(SharedDataEntry));
+
+  return entry;
+}
+
+} // namespace
+
+auto TestRun_impl::register_shared_data(
+  std::unique_ptr<SharedDataFactory> factory) -> unsigned long long
+{
+  this->shared_data_factories_.push_back(std::move(factory));
+
+  return this->shared_data_factories_.size() - 1;
+}
+
+auto TestRun_impl::get_shared_data(unsigned long long const index) const
+  -> void const *
+{
+  waypoint::internal::assert(
+    this->shared_data_region_ != nullptr,
+    "Shared data is only available while tests are running");
+
+  return this->shared_data_region_->data() +
+    shared_data_entry(*this->shared_data_region_, index).offset;
+}
+
+auto TestRun_impl::get_shared_data_size(unsigned long long const index) const
+  -> unsigned long long
+{
+  waypoint::internal::assert(
+    this->shared_data_region_ != nullptr,
+    "Shared data is only available while tests are running");
+
+  return shared_data_entry(*this->shared_data_region_, index).size;
+}
+
+void TestRun_impl::build_shared_data()
+{
+  if(this->shared_data_factories_.empty() || this->shared_data_region_)
+  {
+    return;
+  }
+
+  std::vector<SharedDataEntry> entries;
+  entries.reserve(this->shared_data_factories_.size());
+  auto region_size = align_shared_data(
+    this->shared_data_factories_.size() * sizeof(SharedDataEntry));
+  for(auto const &factory : this->shared_data_factories_)
+  {
+    auto const size = factory->size();
+    entries.push_back({region_size, size});
+    region_size = align_shared_data(region_size + size);
+  }
+
+  this->shared_data_region_ =
+    std::make_unique<ReadOnlyRegion>(create_read_only_region(
+      region_size,
+      [this, &entries](unsigned char *const memory)
+      {
+        std::memcpy(
+          memory,
+          entries.data(),
+          entries.size() * sizeof(SharedDataEntry));
+        for(unsigned long long i = 0; i < entries.size(); ++i)
+        {
+          this->shared_data_factories_[i]->build(memory + entries[i].offset);
+        }
+      }));
+}
+
+void TestRun_impl::adopt_shared_data(std::optional<ReadOnlyRegion> region)
+{
+  if(region.has_value())
+  {
+    this->shared_data_region_ =
+      std::make_unique<ReadOnlyRegion>(std::move(region.value()));
+  }
+}
+
+auto TestRun_impl::shared_data_region() const -> ReadOnlyRegion const *
+{
+  return this->shared_data_region_.get();
+}
+
 void TestRun_impl::register_crashed_exit_status(
   TestId const crashed_test_id,
   unsigned long long const exit_status)
 {
-  crashed_exit_statuses_[crashed_test_id] = exit_status;
+  this->crashed_exit_statuses_[crashed_test_id] = exit_status;
 }
 
 auto TestRun_impl::get_crashed_exit_status(TestId const test_id) const
   -> std::optional<unsigned long long>
 {
-  if(this->crashed_exit_statuses_.contains(test_id))
+  return this->crashed_exit_statuses_[test_id];
+}
+
+void TestRun_impl::set_result_sink(ResultSink *const sink)
+{
+  this->result_sink_ = sink;
+  this->assertion_log_->keep_passing_assertions(sink == nullptr);
+  this->started_tests_.assign(sink == nullptr ? 0 : this->test_count(), false);
+}
+
+auto TestRun_impl::is_streaming() const -> bool
+{
+  return this->result_sink_ != nullptr;
+}
+
+// A test requeued after its worker died may be reported as started
+// again when it is run anew, which is ignored
+void TestRun_impl::report_test_started(TestId const test_id)
+{
+  if(this->result_sink_ == nullptr || this->started_tests_[test_id])
   {
-    return {this->crashed_exit_statuses_.at(test_id)};
+    return;
   }
 
-  return std::nullopt;
+  this->started_tests_[test_id] = true;
+  this->result_sink_->test_started(
+    this->get_group_name(this->get_group_id(test_id)).data(),
+    this->get_test_name(test_id).data(),
+    this->get_test_index(test_id));
+}
+
+// Tests never reported as started, such as those cancelled while
+// queued, are not reported as finished either
+void TestRun_impl::report_test_finished(TestId const test_id)
+{
+  if(this->result_sink_ == nullptr || !this->started_tests_[test_id])
+  {
+    return;
+  }
+
+  this->result_sink_->test_finished(
+    this->get_group_name(this->get_group_id(test_id)).data(),
+    this->get_test_name(test_id).data(),
+    this->summarize_test(test_id).status);
 }
 
 auto TestRun_impl::errors() const noexcept -> std::vector<std::string>
@@ -723,10 +1443,17 @@ void TestRun_impl::register_test_assembly(
   TestAssembly assembly,
   TestId const test_id,
   unsigned long long const timeout_ms,
-  bool const disabled)
+  bool const disabled,
+  bool const isolated,
+  bool const thread_unsafe)
 {
-  this->test_records_
-    .emplace_back(std::move(assembly), test_id, timeout_ms, disabled);
+  this->test_records_.emplace_back(
+    std::move(assembly),
+    test_id,
+    timeout_ms,
+    disabled,
+    isolated,
+    thread_unsafe);
 }
 
 auto TestRun_impl::test_records() -> std::vector<TestRecord> &
@@ -747,22 +1474,19 @@ void TestRun_impl::register_assertion(
   bool const condition,
   TestId const test_id,
   AssertionIndex const index,
-  std::optional<std::string> maybe_message)
+  std::optional<std::string> const &maybe_message)
 {
-  if(condition)
+  if(this->result_sink_ != nullptr)
   {
-    this->passing_assertions_[test_id].emplace_back(
-      condition,
+    this->result_sink_->assertion(
+      this->get_group_name(this->get_group_id(test_id)).data(),
+      this->get_test_name(test_id).data(),
       index,
-      std::move(maybe_message));
-  }
-  else
-  {
-    this->failing_assertions_[test_id].emplace_back(
       condition,
-      index,
-      std::move(maybe_message));
+      maybe_message.has_value() ? maybe_message->c_str() : nullptr);
   }
+
+  this->assertion_log_->append(test_id, condition, index, maybe_message);
 }
 
 void TestRun_impl::transmit_assertion(
@@ -770,47 +1494,28 @@ void TestRun_impl::transmit_assertion(
   TestId const test_id,
   AssertionIndex const index,
   std::optional<std::string> const &maybe_message,
-  InputPipeEnd const &response_write_pipe) const
+  ResponseWriter &response_writer) const
 {
-  constexpr auto code = std::to_underlying(Response::Code::Assertion);
-  response_write_pipe.write(&code, sizeof code);
-
-  unsigned long long const test_id_ = test_id;
-  response_write_pipe.write(
-    reinterpret_cast<unsigned char const *>(&test_id_),
-    sizeof test_id_);
-
-  unsigned char const passed = condition ? 1 : 0;
-  response_write_pipe.write(&passed, sizeof passed);
-
-  unsigned long long const index_ = index;
-  response_write_pipe.write(
-    reinterpret_cast<unsigned char const *>(&index_),
-    sizeof index_);
-
-  if(maybe_message.has_value())
-  {
-    constexpr unsigned char has_message = 1;
-    response_write_pipe.write(&has_message, sizeof has_message);
+  response_writer.stage(Response{
+    Response::Code::Assertion,
+    test_id,
+    condition,
+    index,
+    maybe_message});
+}
 
-    auto const &message = maybe_message.value();
-    unsigned long long const message_size = message.size();
-    response_write_pipe.write(
-      reinterpret_cast<unsigned char const *>(&message_size),
-      sizeof message_size);
-    response_write_pipe.write(
-      reinterpret_cast<unsigned char const *>(message.data()),
-      message_size);
-  }
-  else
+TestRunResult_impl::~TestRunResult_impl()
+{
+  for(unsigned long long i = 0; i < this->summaries_.size(); ++i)
   {
-    constexpr unsigned char has_message = 0;
-    response_write_pipe.write(&has_message, sizeof has_message);
+    delete this->test_outcomes_[i].load(std::memory_order_acquire);
   }
 }
 
 TestRunResult_impl::TestRunResult_impl()
-  : has_failing_assertions_{false}
+  : has_failing_assertions_{false},
+    has_crashes_{false},
+    has_timeouts_{false}
 {
 }
 
@@ -828,22 +1533,41 @@ void TestRunResult_impl::initialize(TestRun const &test_run)
   }
 
   this->has_failing_assertions_ = get_impl(test_run).has_failing_assertions();
+  this->names_ = get_impl(test_run).names();
+  this->assertion_log_ = get_impl(test_run).assertion_log();
 
-  this->test_outcomes_ = std::invoke(
-    [&test_run]()
+  unsigned long long const n = get_impl(test_run).test_count();
+  this->summaries_.reserve(n);
+
+  // Tests of other shards are left to their own reports
+  for(unsigned long long id = 0; id < n; ++id)
+  {
+    if(!get_impl(test_run).is_in_shard(id))
     {
-      unsigned long long const n = get_impl(test_run).test_count();
+      continue;
+    }
 
-      std::vector<std::unique_ptr<TestOutcome>> output;
-      output.reserve(n);
+    auto const &summary =
+      this->summaries_.emplace_back(get_impl(test_run).summarize_test(id));
 
-      for(unsigned long long id = 0; id < n; ++id)
-      {
-        output.emplace_back(get_impl(test_run).make_test_outcome(id));
-      }
+    if(summary.status == TestOutcome::Status::Terminated)
+    {
+      this->has_crashes_ = true;
+    }
+    if(summary.status == TestOutcome::Status::Timeout)
+    {
+      this->has_timeouts_ = true;
+    }
+    if(
+      summary.status != TestOutcome::Status::NotRun &&
+      summary.status != TestOutcome::Status::Success)
+    {
+      this->failing_tests_.push_back(this->summaries_.size() - 1);
+    }
+  }
 
-      return output;
-    });
+  this->test_outcomes_ =
+    std::make_unique<std::atomic<TestOutcome *>[]>(this->summaries_.size());
 }
 
 auto TestRunResult_impl::errors() const -> std::vector<std::string> const &
@@ -863,37 +1587,61 @@ auto TestRunResult_impl::has_failing_assertions() const -> bool
 
 auto TestRunResult_impl::has_crashes() const -> bool
 {
-  auto const it = std::ranges::find_if(
-    this->test_outcomes_,
-    [](auto const &outcome)
-    {
-      return outcome->status() == TestOutcome::Status::Terminated;
-    });
-
-  return it != this->test_outcomes_.end();
+  return this->has_crashes_;
 }
 
 auto TestRunResult_impl::has_timeouts() const -> bool
 {
-  auto const it = std::ranges::find_if(
-    this->test_outcomes_,
-    [](auto const &outcome)
-    {
-      return outcome->status() == TestOutcome::Status::Timeout;
-    });
-
-  return it != this->test_outcomes_.end();
+  return this->has_timeouts_;
 }
 
 auto TestRunResult_impl::test_outcome_count() const -> unsigned long long
 {
-  return this->test_outcomes_.size();
+  return this->summaries_.size();
 }
 
 auto TestRunResult_impl::get_test_outcome(unsigned long long const index) const
   -> TestOutcome const &
 {
-  return *this->test_outcomes_[index];
+  auto &slot = this->test_outcomes_[index];
+
+  auto *outcome = slot.load(std::memory_order_acquire);
+  if(outcome != nullptr)
+  {
+    return *outcome;
+  }
+
+  auto const &summary = this->summaries_[index];
+  auto *const impl = new TestOutcome_impl{};
+  auto built = std::unique_ptr<TestOutcome>(new TestOutcome{impl});
+  impl->initialize(
+    built.get(),
+    &summary,
+    this->assertion_log_->assertions(summary.test_id));
+
+  // Another thread may have built the same outcome in the meantime, in
+  // which case this copy is dropped in favour of the published one
+  if(slot.compare_exchange_strong(
+       outcome,
+       built.get(),
+       std::memory_order_acq_rel,
+       std::memory_order_acquire))
+  {
+    outcome = built.release();
+  }
+
+  return *outcome;
+}
+
+auto TestRunResult_impl::failing_test_count() const -> unsigned long long
+{
+  return this->failing_tests_.size();
+}
+
+auto TestRunResult_impl::get_failing_test_outcome(
+  unsigned long long const index) const -> TestOutcome const &
+{
+  return this->get_test_outcome(this->failing_tests_[index]);
 }
 
 AutorunFunctionPtrVector_impl::~AutorunFunctionPtrVector_impl() = default;
@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -8,11 +8,20 @@ namespace waypoint
 {
 
 class Context;
+class RunConfig;
 class TestRun;
 class Group;
 class TestRunResult;
 class Test;
 class TestOutcome;
+class ResultSink;
+template<typename T>
+class GroupFixture;
+template<typename T>
+class SnapshotFixture;
+template<typename T>
+class SharedData;
+class SharedBytes;
 
 } // namespace waypoint
 
@@ -25,6 +34,7 @@ class AssertionOutcome_impl;
 class AutorunFunctionPtrVector_impl;
 class ContextInProcess_impl;
 class ContextChildProcess_impl;
+class RunConfig_impl;
 class TestRun_impl;
 class Group_impl;
 class TestRunResult_impl;
@@ -32,6 +42,7 @@ class Test_impl;
 class TestOutcome_impl;
 
 auto get_impl(TestRun const &test_run) -> TestRun_impl &;
+auto get_impl(RunConfig const &config) -> RunConfig_impl &;
 
 template<typename T>
 struct remove_reference
@@ -112,6 +123,23 @@ struct enable_if<true, T>
   using type = T;
 };
 
+// Functions passed by name are stored as function pointers
+template<typename T>
+struct decay_function
+{
+  using type = T;
+};
+
+template<typename R, typename... Args>
+struct decay_function<R(Args...)>
+{
+  using type = R (*)(Args...);
+};
+
+template<typename F>
+using stored_callable_t =
+  typename decay_function<typename remove_reference<F>::type>::type;
+
 template<typename T>
 auto declval() -> T;
 
@@ -439,6 +467,177 @@ using TestBodyWithFixture = Function<void(Context const &, FixtureT &)>;
 template<typename FixtureT>
 using TeardownWithFixture = Function<void(Context const &, FixtureT &)>;
 
+class GroupFixtureFactory
+{
+public:
+  virtual ~GroupFixtureFactory();
+  GroupFixtureFactory();
+  GroupFixtureFactory(GroupFixtureFactory const &other) = delete;
+  GroupFixtureFactory(GroupFixtureFactory &&other) noexcept = delete;
+  auto operator=(GroupFixtureFactory const &other)
+    -> GroupFixtureFactory & = delete;
+  auto operator=(GroupFixtureFactory &&other) noexcept
+    -> GroupFixtureFactory & = delete;
+
+  [[nodiscard]]
+  virtual auto create() -> void * = 0;
+  virtual void destroy(void *value) noexcept = 0;
+};
+
+template<typename T, typename F>
+class GroupFixtureFactoryFor final : public GroupFixtureFactory
+{
+public:
+  ~GroupFixtureFactoryFor() override = default;
+  GroupFixtureFactoryFor() = delete;
+  GroupFixtureFactoryFor(GroupFixtureFactoryFor const &other) = delete;
+  GroupFixtureFactoryFor(GroupFixtureFactoryFor &&other) noexcept = delete;
+  auto operator=(GroupFixtureFactoryFor const &other)
+    -> GroupFixtureFactoryFor & = delete;
+  auto operator=(GroupFixtureFactoryFor &&other) noexcept
+    -> GroupFixtureFactoryFor & = delete;
+
+  template<typename G>
+  // NOLINTNEXTLINE(bugprone-forwarding-reference-overload,cppcoreguidelines-missing-std-forward)
+  explicit GroupFixtureFactoryFor(G &&g)
+    : fn_(internal::forward<G>(g))
+  {
+  }
+
+  auto create() -> void * override
+  {
+    return new T(this->fn_());
+  }
+
+  void destroy(void *const value) noexcept override
+  {
+    delete static_cast<T *>(value);
+  }
+
+private:
+  F fn_;
+};
+
+struct PlacementTag
+{
+};
+
+} // namespace waypoint::internal
+
+// Placement new without <new>, for values built in memory owned
+// by the framework
+inline auto operator new(
+  decltype(sizeof(0)) /*size*/,
+  void *const place,
+  waypoint::internal::PlacementTag /*tag*/) noexcept -> void *
+{
+  return place;
+}
+
+inline void operator delete(
+  void * /*ptr*/,
+  void * /*place*/,
+  waypoint::internal::PlacementTag /*tag*/) noexcept
+{
+}
+
+namespace waypoint::internal
+{
+
+class SharedDataFactory
+{
+public:
+  virtual ~SharedDataFactory();
+  SharedDataFactory();
+  SharedDataFactory(SharedDataFactory const &other) = delete;
+  SharedDataFactory(SharedDataFactory &&other) noexcept = delete;
+  auto operator=(SharedDataFactory const &other)
+    -> SharedDataFactory & = delete;
+  auto operator=(SharedDataFactory &&other) noexcept
+    -> SharedDataFactory & = delete;
+
+  [[nodiscard]]
+  virtual auto size() const -> unsigned long long = 0;
+  // Writes the size() bytes of the value to destination
+  virtual void build(unsigned char *destination) = 0;
+};
+
+// Memory given to shared data is aligned to this
+constexpr unsigned long long SHARED_DATA_ALIGNMENT = 64;
+
+template<typename T, typename F>
+class SharedDataFactoryFor final : public SharedDataFactory
+{
+public:
+  ~SharedDataFactoryFor() override = default;
+  SharedDataFactoryFor() = delete;
+  SharedDataFactoryFor(SharedDataFactoryFor const &other) = delete;
+  SharedDataFactoryFor(SharedDataFactoryFor &&other) noexcept = delete;
+  auto operator=(SharedDataFactoryFor const &other)
+    -> SharedDataFactoryFor & = delete;
+  auto operator=(SharedDataFactoryFor &&other) noexcept
+    -> SharedDataFactoryFor & = delete;
+
+  template<typename G>
+  // NOLINTNEXTLINE(bugprone-forwarding-reference-overload,cppcoreguidelines-missing-std-forward)
+  explicit SharedDataFactoryFor(G &&g)
+    : fn_(internal::forward<G>(g))
+  {
+  }
+
+  [[nodiscard]]
+  auto size() const -> unsigned long long override
+  {
+    return sizeof(T);
+  }
+
+  void build(unsigned char *const destination) override
+  {
+    // The value returned is constructed in place, never on the stack
+    ::new(static_cast<void *>(destination), PlacementTag{}) T(this->fn_());
+  }
+
+private:
+  F fn_;
+};
+
+template<typename F>
+class SharedBytesFactoryFor final : public SharedDataFactory
+{
+public:
+  ~SharedBytesFactoryFor() override = default;
+  SharedBytesFactoryFor() = delete;
+  SharedBytesFactoryFor(SharedBytesFactoryFor const &other) = delete;
+  SharedBytesFactoryFor(SharedBytesFactoryFor &&other) noexcept = delete;
+  auto operator=(SharedBytesFactoryFor const &other)
+    -> SharedBytesFactoryFor & = delete;
+  auto operator=(SharedBytesFactoryFor &&other) noexcept
+    -> SharedBytesFactoryFor & = delete;
+
+  template<typename G>
+  // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+  SharedBytesFactoryFor(unsigned long long const size, G &&g)
+    : size_{size},
+      fn_(internal::forward<G>(g))
+  {
+  }
+
+  [[nodiscard]]
+  auto size() const -> unsigned long long override
+  {
+    return this->size_;
+  }
+
+  void build(unsigned char *const destination) override
+  {
+    this->fn_(destination);
+  }
+
+private:
+  unsigned long long size_;
+  F fn_;
+};
+
 template<typename T>
 class UniquePtr
 {
@@ -459,10 +658,10 @@ private:
   T *ptr_;
 };
 
-extern template class UniquePtr<AssertionOutcome_impl>;
 extern template class UniquePtr<AutorunFunctionPtrVector_impl>;
 extern template class UniquePtr<ContextInProcess_impl>;
 extern template class UniquePtr<ContextChildProcess_impl>;
+extern template class UniquePtr<RunConfig_impl>;
 extern template class UniquePtr<TestRun_impl>;
 extern template class UniquePtr<Group_impl>;
 extern template class UniquePtr<Test_impl>;
@@ -489,16 +688,113 @@ public:
   auto test(Group const &group, char const *name) const noexcept
     -> waypoint::Test;
 
+  // The fixture is built once in each process running tests of the
+  // group, before the first of them, and destroyed once the process
+  // is done running tests. Building it does not count towards the
+  // timeout of the test waiting for it.
+  template<typename F>
+  [[nodiscard]]
+  // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+  auto group_fixture(Group const &group, F &&f) const noexcept
+    -> GroupFixture<typename internal::invoke_result<F>::type>
+  {
+    using T = typename internal::invoke_result<F>::type;
+
+    auto const index = this->register_group_fixture(
+      group,
+      new internal::GroupFixtureFactoryFor<
+        T,
+        internal::stored_callable_t<F>>{internal::forward<F>(f)},
+      false);
+
+    return GroupFixture<T>{*this, index};
+  }
+
+  // Like a group fixture, but every test of the group starts from the
+  // value as built. Tests running in worker processes are isolated and
+  // receive a copy-on-write snapshot of the fixture built once by their
+  // worker; in-process runners rebuild it after each test.
+  template<typename F>
+  [[nodiscard]]
+  // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+  auto snapshot_fixture(Group const &group, F &&f) const noexcept
+    -> SnapshotFixture<typename internal::invoke_result<F>::type>
+  {
+    using T = typename internal::invoke_result<F>::type;
+
+    auto const index = this->register_group_fixture(
+      group,
+      new internal::GroupFixtureFactoryFor<
+        T,
+        internal::stored_callable_t<F>>{internal::forward<F>(f)},
+      true);
+
+    return SnapshotFixture<T>{*this, index};
+  }
+
+  // Built once by the process starting the run and shared read-only
+  // with every worker process, which maps it instead of building its
+  // own copy. T must be trivially copyable, as its bytes are shared.
+  // The value f returns is constructed directly in the shared memory,
+  // so it may be larger than the stack.
+  template<typename F>
+  [[nodiscard]]
+  // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+  auto shared_data(F &&f) const noexcept
+    -> SharedData<typename internal::invoke_result<F>::type>
+  {
+    using T = typename internal::invoke_result<F>::type;
+    static_assert(
+      __is_trivially_copyable(T),
+      "Shared data must be trivially copyable");
+    static_assert(
+      alignof(T) <= internal::SHARED_DATA_ALIGNMENT,
+      "Shared data must not be over-aligned");
+
+    auto const index = this->register_shared_data(
+      new internal::SharedDataFactoryFor<
+        T,
+        internal::stored_callable_t<F>>{internal::forward<F>(f)});
+
+    return SharedData<T>{*this, index};
+  }
+
+  // Like shared_data, for data whose size is only known at run time,
+  // such as a corpus loaded from a file. Only the process starting
+  // the run calls fill, which writes size bytes to the destination
+  // it is given; workers see the size it was built with.
+  template<typename F>
+  [[nodiscard]]
+  // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+  auto shared_bytes(unsigned long long const size, F &&fill) const noexcept
+    -> SharedBytes;
+
   static auto create() -> TestRun;
 
 private:
   explicit TestRun(internal::TestRun_impl *impl);
 
+  auto register_group_fixture(
+    Group const &group,
+    internal::GroupFixtureFactory *factory,
+    bool is_snapshot) const -> unsigned long long;
+  [[nodiscard]]
+  auto get_group_fixture(unsigned long long index) const -> void *;
+  auto register_shared_data(internal::SharedDataFactory *factory) const
+    -> unsigned long long;
+  [[nodiscard]]
+  auto get_shared_data(unsigned long long index) const -> void const *;
+  [[nodiscard]]
+  auto get_shared_data_size(unsigned long long index) const
+    -> unsigned long long;
+
   void register_test_assembly(
     internal::TestAssembly f,
     unsigned long long test_id,
     unsigned long long timeout_ms,
-    bool disabled) const;
+    bool disabled,
+    bool isolated,
+    bool thread_unsafe) const;
   void report_incomplete_test(unsigned long long test_id) const;
 
   internal::UniquePtr<internal::TestRun_impl> const impl_;
@@ -508,8 +804,161 @@ private:
 
   template<typename FixtureT>
   friend class internal::Registrar;
+  template<typename T>
+  friend class GroupFixture;
+  template<typename T>
+  friend class SnapshotFixture;
+  template<typename T>
+  friend class SharedData;
+  friend class SharedBytes;
+};
+
+template<typename T>
+class GroupFixture
+{
+public:
+  ~GroupFixture() = default;
+  GroupFixture() = delete;
+  GroupFixture(GroupFixture const &other) = default;
+  GroupFixture(GroupFixture &&other) noexcept = default;
+  auto operator=(GroupFixture const &other) -> GroupFixture & = default;
+  auto operator=(GroupFixture &&other) noexcept -> GroupFixture & = default;
+
+  [[nodiscard]]
+  auto get() const -> T const &
+  {
+    return *static_cast<T const *>(
+      this->test_run_->get_group_fixture(this->index_));
+  }
+
+private:
+  GroupFixture(TestRun const &test_run, unsigned long long const index)
+    : test_run_{&test_run},
+      index_{index}
+  {
+  }
+
+  TestRun const *test_run_;
+  unsigned long long index_;
+
+  friend class TestRun;
 };
 
+template<typename T>
+class SnapshotFixture
+{
+public:
+  ~SnapshotFixture() = default;
+  SnapshotFixture() = delete;
+  SnapshotFixture(SnapshotFixture const &other) = default;
+  SnapshotFixture(SnapshotFixture &&other) noexcept = default;
+  auto operator=(SnapshotFixture const &other) -> SnapshotFixture & = default;
+  auto operator=(SnapshotFixture &&other) noexcept
+    -> SnapshotFixture & = default;
+
+  // Changes are private to the test making them
+  [[nodiscard]]
+  auto get() const -> T &
+  {
+    return *static_cast<T *>(
+      this->test_run_->get_group_fixture(this->index_));
+  }
+
+private:
+  SnapshotFixture(TestRun const &test_run, unsigned long long const index)
+    : test_run_{&test_run},
+      index_{index}
+  {
+  }
+
+  TestRun const *test_run_;
+  unsigned long long index_;
+
+  friend class TestRun;
+};
+
+template<typename T>
+class SharedData
+{
+public:
+  ~SharedData() = default;
+  SharedData() = delete;
+  SharedData(SharedData const &other) = default;
+  SharedData(SharedData &&other) noexcept = default;
+  auto operator=(SharedData const &other) -> SharedData & = default;
+  auto operator=(SharedData &&other) noexcept -> SharedData & = default;
+
+  // Only valid while tests are running
+  [[nodiscard]]
+  auto get() const -> T const &
+  {
+    return *static_cast<T const *>(
+      this->test_run_->get_shared_data(this->index_));
+  }
+
+private:
+  SharedData(TestRun const &test_run, unsigned long long const index)
+    : test_run_{&test_run},
+      index_{index}
+  {
+  }
+
+  TestRun const *test_run_;
+  unsigned long long index_;
+
+  friend class TestRun;
+};
+
+class SharedBytes
+{
+public:
+  ~SharedBytes() = default;
+  SharedBytes() = delete;
+  SharedBytes(SharedBytes const &other) = default;
+  SharedBytes(SharedBytes &&other) noexcept = default;
+  auto operator=(SharedBytes const &other) -> SharedBytes & = default;
+  auto operator=(SharedBytes &&other) noexcept -> SharedBytes & = default;
+
+  // Only valid while tests are running
+  [[nodiscard]]
+  auto data() const -> unsigned char const *
+  {
+    return static_cast<unsigned char const *>(
+      this->test_run_->get_shared_data(this->index_));
+  }
+
+  // Only valid while tests are running
+  [[nodiscard]]
+  auto size() const -> unsigned long long
+  {
+    return this->test_run_->get_shared_data_size(this->index_);
+  }
+
+private:
+  SharedBytes(TestRun const &test_run, unsigned long long const index)
+    : test_run_{&test_run},
+      index_{index}
+  {
+  }
+
+  TestRun const *test_run_;
+  unsigned long long index_;
+
+  friend class TestRun;
+};
+
+template<typename F>
+auto TestRun::shared_bytes(unsigned long long const size, F &&fill) const
+  noexcept -> SharedBytes
+{
+  auto const index = this->register_shared_data(
+    new internal::SharedBytesFactoryFor<internal::stored_callable_t<F>>{
+      size,
+      internal::forward<F>(fill)});
+
+  return SharedBytes{*this, index};
+}
+
 class Context
 {
 public:
@@ -619,7 +1068,9 @@ public:
       },
       this->test_id_,
       this->timeout_ms_,
-      this->is_disabled_);
+      this->is_disabled_,
+      this->is_isolated_,
+      this->is_thread_unsafe_);
   }
 
   Registrar(Registrar const &other) = delete;
@@ -632,7 +1083,9 @@ public:
       setup_{move(other.setup_)},
       body_{move(other.body_)},
       teardown_{move(other.teardown_)},
-      is_disabled_{false}
+      is_disabled_{false},
+      is_isolated_{other.is_isolated_},
+      is_thread_unsafe_{other.is_thread_unsafe_}
   {
     other.is_active_ = false;
   }
@@ -671,6 +1124,16 @@ public:
     this->is_disabled_ = is_disabled;
   }
 
+  void set_isolated()
+  {
+    this->is_isolated_ = true;
+  }
+
+  void set_thread_unsafe()
+  {
+    this->is_thread_unsafe_ = true;
+  }
+
 private:
   Registrar(TestRun const &test_run, unsigned long long const test_id)
     : is_active_{false},
@@ -680,7 +1143,9 @@ private:
       setup_{},
       body_{},
       teardown_{},
-      is_disabled_{false}
+      is_disabled_{false},
+      is_isolated_{false},
+      is_thread_unsafe_{false}
   {
   }
 
@@ -697,6 +1162,8 @@ private:
   TestBodyWithFixture<FixtureT> body_;
   TeardownWithFixture<FixtureT> teardown_;
   bool is_disabled_;
+  bool is_isolated_;
+  bool is_thread_unsafe_;
 
   friend class waypoint::Test;
 };
@@ -720,6 +1187,8 @@ public:
 
   void set_timeout_ms(unsigned long long timeout_ms);
   void disable(bool is_disabled);
+  void set_isolated();
+  void set_thread_unsafe();
 
 private:
   Registrar(TestRun const &test_run, unsigned long long test_id);
@@ -734,6 +1203,8 @@ private:
   TestBodyNoFixture body_;
   TeardownNoFixture teardown_;
   bool is_disabled_;
+  bool is_isolated_;
+  bool is_thread_unsafe_;
 
   friend class waypoint::Test;
 };
@@ -743,10 +1214,71 @@ private:
 namespace waypoint
 {
 
+class RunConfig
+{
+public:
+  enum class Transport : unsigned char
+  {
+    Pipe,
+    SharedMemory
+  };
+
+  enum class Spawn : unsigned char
+  {
+    Exec,
+    Zygote
+  };
+
+  enum class Isolation : unsigned char
+  {
+    SharedChild,
+    PerTest
+  };
+
+  ~RunConfig();
+  RunConfig();
+  RunConfig(RunConfig const &other) = delete;
+  RunConfig(RunConfig &&other) noexcept = delete;
+  auto operator=(RunConfig const &other) -> RunConfig & = delete;
+  auto operator=(RunConfig &&other) noexcept -> RunConfig & = delete;
+
+  auto workers(unsigned long long count) noexcept -> RunConfig &;
+  auto pipeline_depth(unsigned long long depth) noexcept -> RunConfig &;
+  // How often the runner collects assertions that workers have not
+  // sent yet, so that they are reported while long tests still run.
+  // 0 leaves them until the test ends.
+  auto flush_interval_ms(unsigned long long interval_ms) noexcept
+    -> RunConfig &;
+  auto transport(Transport transport) noexcept -> RunConfig &;
+  auto spawn(Spawn spawn) noexcept -> RunConfig &;
+  auto isolation(Isolation isolation) noexcept -> RunConfig &;
+  auto timing_database(char const *path) noexcept -> RunConfig &;
+  // Overrides WAYPOINT_SHARD_INDEX and WAYPOINT_SHARD_COUNT, which fail
+  // the run if they are set to anything but a number
+  auto shard(unsigned long long index, unsigned long long count) noexcept
+    -> RunConfig &;
+  auto max_failures(unsigned long long count) noexcept -> RunConfig &;
+  // The sink must outlive the runs it is passed to
+  auto result_sink(ResultSink &sink) noexcept -> RunConfig &;
+
+private:
+  internal::UniquePtr<internal::RunConfig_impl> const impl_;
+
+  friend auto internal::get_impl(RunConfig const &config)
+    -> internal::RunConfig_impl &;
+};
+
 [[nodiscard]]
 auto run_all_tests_in_process(TestRun const &t) noexcept -> TestRunResult;
 [[nodiscard]]
+auto run_all_tests_in_process(
+  TestRun const &t,
+  RunConfig const &config) noexcept -> TestRunResult;
+[[nodiscard]]
 auto run_all_tests(TestRun const &t) noexcept -> TestRunResult;
+[[nodiscard]]
+auto run_all_tests(TestRun const &t, RunConfig const &config) noexcept
+  -> TestRunResult;
 
 class AssertionOutcome
 {
@@ -770,11 +1302,15 @@ public:
   auto index() const noexcept -> unsigned long long;
 
 private:
-  explicit AssertionOutcome(internal::AssertionOutcome_impl *impl);
+  AssertionOutcome(
+    TestOutcome const *test_outcome,
+    internal::AssertionOutcome_impl const *impl);
 
-  internal::UniquePtr<internal::AssertionOutcome_impl> const impl_;
+  // Both are owned by the TestRunResult this outcome belongs to
+  TestOutcome const *const test_outcome_;
+  internal::AssertionOutcome_impl const *const impl_;
 
-  friend class internal::TestRun_impl;
+  friend class internal::TestOutcome_impl;
 };
 
 class TestOutcome
@@ -807,6 +1343,13 @@ public:
   auto assertion_outcome(unsigned long long index) const noexcept
     -> AssertionOutcome const &;
   [[nodiscard]]
+  auto failing_assertion_count() const noexcept -> unsigned long long;
+  [[nodiscard]]
+  auto failing_assertion_outcome(unsigned long long index) const noexcept
+    -> AssertionOutcome const &;
+  [[nodiscard]]
+  auto passing_assertion_count() const noexcept -> unsigned long long;
+  [[nodiscard]]
   auto disabled() const noexcept -> bool;
   [[nodiscard]]
   auto status() const noexcept -> TestOutcome::Status;
@@ -818,7 +1361,40 @@ private:
 
   internal::UniquePtr<internal::TestOutcome_impl> const impl_;
 
-  friend class internal::TestRun_impl;
+  friend class internal::TestRunResult_impl;
+};
+
+// Receives results while tests run. With a sink set, passing assertions
+// are only counted once handed to it, so assertion_outcome lists failing
+// ones alone. Calls never overlap. Those of a single test come in order,
+// but different tests' calls may interleave. A test is started when a
+// worker begins running it, and every started test is finished, as not
+// run if the run stops first.
+class ResultSink
+{
+public:
+  virtual ~ResultSink();
+  ResultSink();
+  ResultSink(ResultSink const &other) = delete;
+  ResultSink(ResultSink &&other) noexcept = delete;
+  auto operator=(ResultSink const &other) -> ResultSink & = delete;
+  auto operator=(ResultSink &&other) noexcept -> ResultSink & = delete;
+
+  virtual void test_started(
+    char const *group_name,
+    char const *test_name,
+    unsigned long long test_index) noexcept;
+  // message is nullptr for assertions without one
+  virtual void assertion(
+    char const *group_name,
+    char const *test_name,
+    unsigned long long index,
+    bool passed,
+    char const *message) noexcept;
+  virtual void test_finished(
+    char const *group_name,
+    char const *test_name,
+    TestOutcome::Status status) noexcept;
 };
 
 class Group
@@ -854,6 +1430,20 @@ public:
   auto operator=(Test5 const &other) -> Test5 & = delete;
   auto operator=(Test5 &&other) noexcept -> Test5 & = delete;
 
+  auto isolated() && noexcept -> Test5
+  {
+    this->registrar_.set_isolated();
+
+    return Test5{internal::move(this->registrar_)};
+  }
+
+  auto thread_unsafe() && noexcept -> Test5
+  {
+    this->registrar_.set_thread_unsafe();
+
+    return Test5{internal::move(this->registrar_)};
+  }
+
   void disable() && noexcept
   {
     this->registrar_.disable(true);
@@ -900,6 +1490,20 @@ public:
     return waypoint::Test5<FixtureT>{internal::move(this->registrar_)};
   }
 
+  auto isolated() && noexcept -> Test4
+  {
+    this->registrar_.set_isolated();
+
+    return Test4{internal::move(this->registrar_)};
+  }
+
+  auto thread_unsafe() && noexcept -> Test4
+  {
+    this->registrar_.set_thread_unsafe();
+
+    return Test4{internal::move(this->registrar_)};
+  }
+
   void disable() && noexcept
   {
     this->registrar_.disable(true);
@@ -953,6 +1557,20 @@ public:
     return waypoint::Test5<FixtureT>{internal::move(this->registrar_)};
   }
 
+  auto isolated() && noexcept -> Test3
+  {
+    this->registrar_.set_isolated();
+
+    return Test3{internal::move(this->registrar_)};
+  }
+
+  auto thread_unsafe() && noexcept -> Test3
+  {
+    this->registrar_.set_thread_unsafe();
+
+    return Test3{internal::move(this->registrar_)};
+  }
+
   void disable() && noexcept
   {
     this->registrar_.disable(true);
@@ -1003,6 +1621,8 @@ public:
     return waypoint::Test5{internal::move(this->registrar_)};
   }
 
+  auto isolated() && noexcept -> Test3;
+  auto thread_unsafe() && noexcept -> Test3;
   void disable() && noexcept;
   void disable(bool is_disabled) && noexcept;
 
@@ -1171,6 +1791,13 @@ public:
   [[nodiscard]]
   auto test_outcome(unsigned long long index) const noexcept
     -> TestOutcome const &;
+  // Tests which failed an assertion, crashed or timed out, in the order
+  // of test_outcome
+  [[nodiscard]]
+  auto failing_test_count() const noexcept -> unsigned long long;
+  [[nodiscard]]
+  auto failing_test_outcome(unsigned long long index) const noexcept
+    -> TestOutcome const &;
   [[nodiscard]]
   auto error_count() const noexcept -> unsigned long long;
   [[nodiscard]]
@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -7,12 +7,15 @@
 #include "types.hpp"
 #include "waypoint.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -26,61 +29,133 @@ class TestRun;
 namespace waypoint::internal
 {
 
-class InputPipeEnd;
+class ReadOnlyRegion;
+class ResponseWriter;
 
-class AssertionOutcome_impl
+// Append-only storage holding each distinct group and test name once.
+// The views it hands out are NUL-terminated and stay valid for as long
+// as the table does.
+class NameTable
 {
 public:
-  AssertionOutcome_impl();
+  NameTable();
 
-  void initialize(
-    TestOutcome const *test_outcome,
-    std::optional<std::string> message,
+  [[nodiscard]]
+  auto intern(std::string_view name) -> std::string_view;
+
+private:
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  unsigned long long chunk_capacity_;
+  unsigned long long chunk_used_;
+  std::unordered_set<std::string_view> names_;
+};
+
+// An entry of the AssertionLog. The message, if any, lives in the arena
+// of the log.
+class AssertionOutcome_impl
+{
+public:
+  AssertionOutcome_impl(
     bool passed,
-    unsigned long long index);
+    AssertionIndex index,
+    char const *maybe_message);
 
+  // Returns nullptr if the assertion has no message
   [[nodiscard]]
-  auto group_name() const -> char const *;
-  [[nodiscard]]
-  auto test_name() const -> char const *;
-  [[nodiscard]]
-  auto message() const -> std::optional<std::string> const &;
+  auto message() const -> char const *;
   [[nodiscard]]
   auto passed() const -> bool;
   [[nodiscard]]
-  auto index() const -> unsigned long long;
+  auto index() const -> AssertionIndex;
 
 private:
-  TestOutcome const *test_outcome_;
-  std::optional<std::string> message_;
+  char const *message_;
+  AssertionIndex index_;
   bool passed_;
-  unsigned long long index_;
+};
+
+// Assertions of every test, each test's kept in index order. Entries and
+// messages are carved out of a single arena which is released as a whole
+// with the log. Passing assertions are always counted, but may be left
+// out when only failures are of interest.
+class AssertionLog
+{
+public:
+  AssertionLog();
+
+  void keep_passing_assertions(bool is_kept);
+  void add_test();
+  void append(
+    TestId test_id,
+    bool passed,
+    AssertionIndex index,
+    std::optional<std::string> const &maybe_message);
+  [[nodiscard]]
+  auto assertions(TestId test_id) const
+    -> std::span<AssertionOutcome_impl const>;
+  [[nodiscard]]
+  auto has_failures() const -> bool;
+  [[nodiscard]]
+  auto has_failures(TestId test_id) const -> bool;
+  [[nodiscard]]
+  auto passing_count(TestId test_id) const -> unsigned long long;
+
+private:
+  std::pmr::monotonic_buffer_resource arena_;
+  std::vector<std::pmr::vector<AssertionOutcome_impl>> tests_;
+  std::vector<unsigned long long> passing_counts_;
+  bool has_failures_;
+  bool is_passing_kept_;
+};
+
+// What a TestRunResult keeps of each test. Outcomes are built from it
+// only when asked for.
+struct TestSummary
+{
+  TestId test_id;
+  // Point into the NameTable kept alive by the TestRunResult
+  std::string_view group_name;
+  std::string_view test_name;
+  unsigned long long test_index;
+  unsigned long long passing_assertion_count;
+  std::optional<unsigned long long> exit_status;
+  TestOutcome::Status status;
+  bool disabled;
 };
 
 class TestOutcome_impl
 {
 public:
+  ~TestOutcome_impl();
   TestOutcome_impl();
+  TestOutcome_impl(TestOutcome_impl const &other) = delete;
+  TestOutcome_impl(TestOutcome_impl &&other) noexcept = delete;
+  auto operator=(TestOutcome_impl const &other) -> TestOutcome_impl & = delete;
+  auto operator=(TestOutcome_impl &&other) noexcept
+    -> TestOutcome_impl & = delete;
 
   void initialize(
-    std::vector<std::unique_ptr<AssertionOutcome>> assertion_outcomes,
-    std::string group_name,
-    std::string test_name,
-    unsigned long long index,
-    bool disabled,
-    TestOutcome::Status status,
-    std::optional<unsigned long long> maybe_exit_status);
+    TestOutcome const *test_outcome,
+    TestSummary const *summary,
+    std::span<AssertionOutcome_impl const> assertions);
 
   [[nodiscard]]
-  auto get_test_name() const -> std::string const &;
+  auto get_test_name() const -> std::string_view;
   [[nodiscard]]
-  auto get_group_name() const -> std::string const &;
+  auto get_group_name() const -> std::string_view;
   [[nodiscard]]
   auto get_assertion_count() const -> unsigned long long;
   [[nodiscard]]
   auto get_assertion_outcome(unsigned long long index) const
     -> AssertionOutcome const &;
   [[nodiscard]]
+  auto get_failing_assertion_count() const -> unsigned long long;
+  [[nodiscard]]
+  auto get_failing_assertion_outcome(unsigned long long index) const
+    -> AssertionOutcome const &;
+  [[nodiscard]]
+  auto get_passing_assertion_count() const -> unsigned long long;
+  [[nodiscard]]
   auto get_index() const -> unsigned long long;
   [[nodiscard]]
   auto disabled() const -> bool;
@@ -90,13 +165,12 @@ public:
   auto exit_status() const -> std::optional<unsigned long long> const &;
 
 private:
-  std::vector<std::unique_ptr<AssertionOutcome>> assertion_outcomes_;
-  std::string group_name_;
-  std::string test_name_;
-  unsigned long long test_index_;
-  bool disabled_;
-  TestOutcome::Status status_;
-  std::optional<unsigned long long> exit_status_;
+  // Owned by the TestRunResult
+  TestSummary const *summary_;
+  // One allocation holding an outcome per entry of the AssertionLog
+  AssertionOutcome *assertion_outcomes_;
+  unsigned long long assertion_count_;
+  std::vector<unsigned long long> failing_assertion_indices_;
 };
 
 class TestRecord
@@ -106,7 +180,9 @@ public:
     TestAssembly assembly,
     TestId test_id,
     unsigned long long timeout_ms,
-    bool disabled);
+    bool disabled,
+    bool isolated,
+    bool thread_unsafe);
 
   enum class Status : std::uint8_t
   {
@@ -126,9 +202,22 @@ public:
   auto status() const -> TestRecord::Status;
   [[nodiscard]]
   auto timeout_ms() const -> unsigned long long;
+  [[nodiscard]]
+  auto isolated() const -> bool;
+  void isolate();
+  [[nodiscard]]
+  auto thread_unsafe() const -> bool;
+  [[nodiscard]]
+  auto duration_us() const -> std::optional<unsigned long long>;
+  void set_duration_us(unsigned long long duration_us);
+  [[nodiscard]]
+  auto in_shard() const -> bool;
+  void exclude_from_shard();
   void mark_as_run();
   void mark_as_crashed();
   void mark_as_timed_out();
+  // For tests dispatched but cancelled before they completed
+  void mark_as_not_run();
 
 private:
   TestAssembly test_assembly_;
@@ -136,6 +225,10 @@ private:
   bool disabled_;
   TestRecord::Status status_;
   unsigned long long timeout_ms_;
+  bool isolated_;
+  std::optional<unsigned long long> duration_us_;
+  bool in_shard_;
+  bool thread_unsafe_;
 };
 
 class AssertionRecord
@@ -159,6 +252,9 @@ private:
   std::optional<std::string> maybe_message_;
 };
 
+// Assertions made on a runner thread, registered once it is done
+using AssertionBuffer = std::vector<std::pair<TestId, AssertionRecord>>;
+
 class Group_impl
 {
 public:
@@ -201,19 +297,20 @@ class ContextInProcess_impl
 public:
   ContextInProcess_impl();
 
-  void initialize(TestRun const &test_run, TestId test_id);
+  void initialize(
+    TestRun const &test_run,
+    TestId test_id,
+    AssertionBuffer *assertion_buffer);
 
-  [[nodiscard]]
-  auto get_test_run() const -> TestRun const &;
-  [[nodiscard]]
-  auto generate_assertion_index() -> AssertionIndex;
-  [[nodiscard]]
-  auto test_id() const -> TestId;
+  void register_assertion(
+    bool condition,
+    std::optional<std::string> maybe_message);
 
 private:
   TestRun const *test_run_;
   TestId test_id_;
   AssertionIndex assertion_index_;
+  AssertionBuffer *assertion_buffer_;
 };
 
 class ContextChildProcess_impl
@@ -224,7 +321,7 @@ public:
   void initialize(
     TestRun const &test_run,
     TestId test_id,
-    InputPipeEnd const &response_write_pipe,
+    ResponseWriter &response_writer,
     std::mutex &transmission_mutex);
 
   [[nodiscard]]
@@ -234,7 +331,7 @@ public:
   [[nodiscard]]
   auto test_id() const -> TestId;
   [[nodiscard]]
-  auto response_write_pipe() const -> InputPipeEnd const *;
+  auto response_writer() const -> ResponseWriter *;
   [[nodiscard]]
   auto transmission_mutex() const -> std::mutex *;
 
@@ -242,14 +339,108 @@ private:
   TestRun const *test_run_;
   TestId test_id_;
   AssertionIndex assertion_index_;
-  InputPipeEnd const *response_write_pipe_;
+  ResponseWriter *response_writer_;
   std::mutex *transmission_mutex_;
 };
 
+class RunConfig_impl
+{
+public:
+  RunConfig_impl();
+
+  void set_worker_count(unsigned long long count);
+  [[nodiscard]]
+  auto worker_count() const -> unsigned long long;
+  void set_pipeline_depth(unsigned long long depth);
+  [[nodiscard]]
+  auto pipeline_depth() const -> unsigned long long;
+  void set_flush_interval_ms(unsigned long long interval_ms);
+  [[nodiscard]]
+  auto flush_interval_ms() const -> unsigned long long;
+  void set_transport(RunConfig::Transport transport);
+  [[nodiscard]]
+  auto transport() const -> RunConfig::Transport;
+  void set_spawn(RunConfig::Spawn spawn);
+  [[nodiscard]]
+  auto spawn() const -> RunConfig::Spawn;
+  void set_isolation(RunConfig::Isolation isolation);
+  [[nodiscard]]
+  auto isolation() const -> RunConfig::Isolation;
+  void set_timing_database(std::string path);
+  [[nodiscard]]
+  auto timing_database() const -> std::optional<std::string> const &;
+  void set_shard(unsigned long long index, unsigned long long count);
+  [[nodiscard]]
+  auto shard_index() const -> unsigned long long;
+  [[nodiscard]]
+  auto shard_count() const -> unsigned long long;
+  [[nodiscard]]
+  auto malformed_shard_variable() const -> std::optional<std::string> const &;
+  void set_max_failures(unsigned long long count);
+  [[nodiscard]]
+  auto max_failures() const -> unsigned long long;
+  void set_result_sink(ResultSink *sink);
+  [[nodiscard]]
+  auto result_sink() const -> ResultSink *;
+
+private:
+  unsigned long long worker_count_;
+  unsigned long long pipeline_depth_;
+  unsigned long long flush_interval_ms_;
+  RunConfig::Transport transport_;
+  RunConfig::Spawn spawn_;
+  RunConfig::Isolation isolation_;
+  std::optional<std::string> timing_database_;
+  unsigned long long shard_index_;
+  unsigned long long shard_count_;
+  std::optional<std::string> malformed_shard_variable_;
+  unsigned long long max_failures_;
+  ResultSink *result_sink_;
+};
+
+class GroupFixtureRecord
+{
+public:
+  ~GroupFixtureRecord();
+  GroupFixtureRecord(
+    GroupId group_id,
+    std::unique_ptr<GroupFixtureFactory> factory,
+    bool is_snapshot);
+  GroupFixtureRecord(GroupFixtureRecord const &other) = delete;
+  GroupFixtureRecord(GroupFixtureRecord &&other) noexcept = delete;
+  auto operator=(GroupFixtureRecord const &other)
+    -> GroupFixtureRecord & = delete;
+  auto operator=(GroupFixtureRecord &&other) noexcept
+    -> GroupFixtureRecord & = delete;
+
+  [[nodiscard]]
+  auto group_id() const -> GroupId;
+  [[nodiscard]]
+  auto is_snapshot() const -> bool;
+  [[nodiscard]]
+  auto is_built() -> bool;
+  // Builds the value on first use
+  [[nodiscard]]
+  auto get() -> void *;
+  void tear_down();
+
+private:
+  GroupId group_id_;
+  std::unique_ptr<GroupFixtureFactory> factory_;
+  bool is_snapshot_;
+  std::mutex mutex_;
+  void *value_;
+};
+
 class TestRun_impl
 {
 public:
+  ~TestRun_impl();
   TestRun_impl();
+  TestRun_impl(TestRun_impl const &other) = delete;
+  TestRun_impl(TestRun_impl &&other) noexcept = delete;
+  auto operator=(TestRun_impl const &other) -> TestRun_impl & = delete;
+  auto operator=(TestRun_impl &&other) noexcept -> TestRun_impl & = delete;
 
 private:
   using GroupName = std::string;
@@ -258,7 +449,8 @@ private:
   enum class ErrorType : std::uint8_t
   {
     Init_DuplicateTestInGroup,
-    Init_TestHasNoBody
+    Init_TestHasNoBody,
+    Config_InvalidShard
   };
 
   struct Error
@@ -273,7 +465,9 @@ public:
     TestAssembly assembly,
     TestId test_id,
     unsigned long long timeout_ms,
-    bool disabled);
+    bool disabled,
+    bool isolated,
+    bool thread_unsafe);
   [[nodiscard]]
   auto test_records() -> std::vector<TestRecord> &;
   [[nodiscard]]
@@ -282,13 +476,13 @@ public:
     bool condition,
     TestId test_id,
     AssertionIndex index,
-    std::optional<std::string> maybe_message);
+    std::optional<std::string> const &maybe_message);
   void transmit_assertion(
     bool condition,
     TestId test_id,
     AssertionIndex index,
     std::optional<std::string> const &maybe_message,
-    InputPipeEnd const &response_write_pipe) const;
+    ResponseWriter &response_writer) const;
   [[nodiscard]]
   auto errors() const noexcept -> std::vector<std::string>;
   [[nodiscard]]
@@ -306,36 +500,40 @@ public:
   [[nodiscard]]
   auto get_group_id(Group const &group) const -> GroupId;
   [[nodiscard]]
-  auto get_group_name(GroupId id) const -> std::string;
+  auto get_group_name(GroupId id) const -> std::string_view;
+  [[nodiscard]]
+  auto get_test_name(TestId id) const -> std::string_view;
   [[nodiscard]]
-  auto get_test_name(TestId id) const -> std::string;
+  auto names() const -> std::shared_ptr<NameTable const>;
   void set_test_index(TestId test_id, unsigned long long index);
   [[nodiscard]]
   auto get_test_index(TestId test_id) const -> unsigned long long;
   [[nodiscard]]
   auto test_count() const -> unsigned long long;
   [[nodiscard]]
-  auto make_test_outcome(TestId test_id) const noexcept
-    -> std::unique_ptr<TestOutcome>;
+  auto summarize_test(TestId test_id) const -> TestSummary;
   void report_error(ErrorType type, std::string const &message);
   void report_duplicate_test_name(
-    GroupName const &group_name,
-    TestName const &test_name);
+    std::string_view group_name,
+    std::string_view test_name);
   void report_incomplete_test(TestId test_id);
+  void report_invalid_shard(
+    unsigned long long shard_index,
+    unsigned long long shard_count);
+  void report_malformed_shard(std::string const &variable);
   [[nodiscard]]
-  auto get_passing_assertions(TestId test_id) const
-    -> std::vector<AssertionRecord>;
-  [[nodiscard]]
-  auto get_failing_assertions(TestId test_id) const
-    -> std::vector<AssertionRecord>;
+  auto assertion_log() const -> std::shared_ptr<AssertionLog const>;
   [[nodiscard]]
   auto has_failing_assertions() const -> bool;
   [[nodiscard]]
-  auto make_in_process_context(TestId test_id) const
-    -> std::unique_ptr<Context>;
+  auto has_failing_assertions(TestId test_id) const -> bool;
+  [[nodiscard]]
+  auto make_in_process_context(
+    TestId test_id,
+    AssertionBuffer *assertion_buffer) const -> std::unique_ptr<Context>;
   auto make_child_process_context(
     TestId test_id,
-    InputPipeEnd const &response_write_pipe,
+    ResponseWriter &response_writer,
     std::mutex &transmission_mutex) const -> std::unique_ptr<Context>;
   void set_shuffled_test_record_ptrs();
   [[nodiscard]]
@@ -343,34 +541,91 @@ public:
     -> std::vector<TestRecord *> const &;
   [[nodiscard]]
   auto is_disabled(TestId test_id) const -> bool;
+  void select_shard(
+    unsigned long long shard_index,
+    unsigned long long shard_count);
+  [[nodiscard]]
+  auto is_in_shard(TestId test_id) const -> bool;
+  auto register_group_fixture(
+    GroupId group_id,
+    std::unique_ptr<GroupFixtureFactory> factory,
+    bool is_snapshot) -> unsigned long long;
+  [[nodiscard]]
+  auto get_group_fixture(unsigned long long index) const -> void *;
+  [[nodiscard]]
+  auto has_group_fixtures(GroupId group_id) const -> bool;
+  [[nodiscard]]
+  auto has_snapshot_fixtures(GroupId group_id) const -> bool;
+  // Returns false if the fixtures of the group are all built already
+  [[nodiscard]]
+  auto has_unbuilt_group_fixtures(GroupId group_id) const -> bool;
+  void build_group_fixtures(GroupId group_id) const;
+  void tear_down_group_fixtures() const;
+  void tear_down_snapshot_fixtures(GroupId group_id) const;
+  auto register_shared_data(std::unique_ptr<SharedDataFactory> factory)
+    -> unsigned long long;
+  [[nodiscard]]
+  auto get_shared_data(unsigned long long index) const -> void const *;
+  [[nodiscard]]
+  auto get_shared_data_size(unsigned long long index) const
+    -> unsigned long long;
+  // Builds every shared value into one read-only region, unless there
+  // are none or the region has been built already
+  void build_shared_data();
+  // Child processes map the region built by their parent instead
+  void adopt_shared_data(std::optional<ReadOnlyRegion> region);
+  [[nodiscard]]
+  auto shared_data_region() const -> ReadOnlyRegion const *;
   void register_crashed_exit_status(
     TestId crashed_test_id,
     unsigned long long exit_status);
   auto get_crashed_exit_status(TestId test_id) const
     -> std::optional<unsigned long long>;
+  // Results are streamed to the sink, if any, instead of being kept
+  void set_result_sink(ResultSink *sink);
+  [[nodiscard]]
+  auto is_streaming() const -> bool;
+  void report_test_started(TestId test_id);
+  void report_test_finished(TestId test_id);
 
 private:
   TestRun const *test_run_;
   GroupId group_id_counter_;
   TestId test_id_counter_;
-  std::unordered_map<GroupId, GroupName> group_id2group_name_;
-  std::unordered_map<TestId, TestName> test_id2test_name_;
-  std::unordered_map<TestId, GroupId> test_id2group_id_;
-  std::unordered_map<TestId, unsigned long long> test_id2test_index_;
-  std::unordered_map<GroupId, std::unordered_set<TestName>>
-    test_names_per_group_;
-  std::vector<Error> errors_;
-  std::unordered_map<TestId, std::vector<AssertionRecord>> passing_assertions_;
-  std::unordered_map<TestId, std::vector<AssertionRecord>> failing_assertions_;
+  // Ids are handed out in sequence, so the vectors below are indexed
+  // by them directly, one element per group or test
+  std::shared_ptr<NameTable> names_;
+  std::vector<std::string_view> group_names_;
+  // Interned names are equal exactly when they share their address
+  std::vector<std::unordered_set<char const *>> test_names_per_group_;
+  std::vector<std::string_view> test_names_;
+  std::vector<GroupId> test_group_ids_;
+  std::vector<unsigned long long> test_indices_;
+  std::shared_ptr<AssertionLog> assertion_log_;
+  std::vector<std::optional<unsigned long long>> crashed_exit_statuses_;
   std::vector<TestRecord> test_records_;
   std::vector<TestRecord *> shuffled_test_record_ptrs_;
-  std::unordered_map<TestId, unsigned long long> crashed_exit_statuses_;
+  std::vector<Error> errors_;
+  std::vector<std::unique_ptr<GroupFixtureRecord>> group_fixtures_;
+  std::vector<std::unique_ptr<SharedDataFactory>> shared_data_factories_;
+  std::unique_ptr<ReadOnlyRegion> shared_data_region_;
+  ResultSink *result_sink_;
+  std::vector<bool> started_tests_;
 };
 
+// A view over what the TestRun recorded. Each TestOutcome is built the
+// first time it is asked for.
 class TestRunResult_impl
 {
 public:
+  ~TestRunResult_impl();
   TestRunResult_impl();
+  TestRunResult_impl(TestRunResult_impl const &other) = delete;
+  TestRunResult_impl(TestRunResult_impl &&other) noexcept = delete;
+  auto operator=(TestRunResult_impl const &other)
+    -> TestRunResult_impl & = delete;
+  auto operator=(TestRunResult_impl &&other) noexcept
+    -> TestRunResult_impl & = delete;
 
   void initialize(TestRun const &test_run);
 
@@ -388,10 +643,23 @@ public:
   auto test_outcome_count() const -> unsigned long long;
   [[nodiscard]]
   auto get_test_outcome(unsigned long long index) const -> TestOutcome const &;
+  [[nodiscard]]
+  auto failing_test_count() const -> unsigned long long;
+  [[nodiscard]]
+  auto get_failing_test_outcome(unsigned long long index) const
+    -> TestOutcome const &;
 
 private:
   bool has_failing_assertions_;
-  std::vector<std::unique_ptr<TestOutcome>> test_outcomes_;
+  bool has_crashes_;
+  bool has_timeouts_;
+  std::shared_ptr<NameTable const> names_;
+  std::shared_ptr<AssertionLog const> assertion_log_;
+  std::vector<TestSummary> summaries_;
+  // Positions in summaries_ of tests which failed, crashed or timed out
+  std::vector<unsigned long long> failing_tests_;
+  // Null until the outcome at the same position is first asked for
+  std::unique_ptr<std::atomic<TestOutcome *>[]> test_outcomes_;
   std::vector<std::string> errors_;
 };
 
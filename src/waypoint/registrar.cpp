@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -38,7 +38,9 @@ Registrar<void>::~Registrar()
     },
     this->test_id_,
     this->timeout_ms_,
-    this->is_disabled_);
+    this->is_disabled_,
+    this->is_isolated_,
+    this->is_thread_unsafe_);
 }
 
 Registrar<void>::Registrar(Registrar &&other) noexcept
@@ -49,7 +51,9 @@ Registrar<void>::Registrar(Registrar &&other) noexcept
     setup_{move(other.setup_)},
     body_{move(other.body_)},
     teardown_{move(other.teardown_)},
-    is_disabled_{false}
+    is_disabled_{false},
+    is_isolated_{other.is_isolated_},
+    is_thread_unsafe_{other.is_thread_unsafe_}
 {
   other.is_active_ = false;
 }
@@ -85,6 +89,16 @@ void Registrar<void>::disable(bool const is_disabled)
   this->is_disabled_ = is_disabled;
 }
 
+void Registrar<void>::set_isolated()
+{
+  this->is_isolated_ = true;
+}
+
+void Registrar<void>::set_thread_unsafe()
+{
+  this->is_thread_unsafe_ = true;
+}
+
 Registrar<void>::Registrar(
   TestRun const &test_run,
   unsigned long long const test_id)
@@ -92,7 +106,9 @@ Registrar<void>::Registrar(
     test_run_{test_run},
     test_id_{test_id},
     timeout_ms_{DEFAULT_TIMEOUT_MS},
-    is_disabled_{false}
+    is_disabled_{false},
+    is_isolated_{false},
+    is_thread_unsafe_{false}
 {
 }
 
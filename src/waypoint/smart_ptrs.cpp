@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -38,10 +38,10 @@ auto UniquePtr<T>::operator*() const -> T &
   return *ptr_;
 }
 
-template class UniquePtr<AssertionOutcome_impl>;
 template class UniquePtr<AutorunFunctionPtrVector_impl>;
 template class UniquePtr<ContextInProcess_impl>;
 template class UniquePtr<ContextChildProcess_impl>;
+template class UniquePtr<RunConfig_impl>;
 template class UniquePtr<TestRun_impl>;
 template class UniquePtr<Group_impl>;
 template class UniquePtr<Test_impl>;
@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Wojciech Kałuża
+// Copyright (c) 2025-2026 Wojciech Kałuża
 // SPDX-License-Identifier: MIT
 // For license details, see LICENSE file
 
@@ -9,20 +9,21 @@
 
 #include "coverage/coverage.hpp"
 #include "process/process.hpp"
+#include "timing_database/timing_database.hpp"
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <functional>
-#include <latch>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <span>
+#include <ranges>
 #include <string>
 #include <thread>
-#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -75,105 +76,15 @@ auto get_impl(TestRun const &test_run) -> TestRun_impl &
   return *test_run.impl_;
 }
 
-} // namespace waypoint::internal
-
-namespace
-{
-
-void send_timeout(
-  waypoint::internal::InputPipeEnd const &response_write_pipe,
-  waypoint::TestId const test_id)
+auto get_impl(RunConfig const &config) -> RunConfig_impl &
 {
-  constexpr auto code =
-    std::to_underlying(waypoint::internal::Response::Code::Timeout);
-  response_write_pipe.write(&code, sizeof code);
-
-  unsigned long long const test_id_ = test_id;
-  response_write_pipe.write(
-    reinterpret_cast<unsigned char const *>(&test_id_),
-    sizeof test_id_);
+  return *config.impl_;
 }
 
-class Timeout
-{
-public:
-  ~Timeout()
-  {
-    this->thread_.join();
-  }
-
-  Timeout(Timeout const &other) = delete;
-  Timeout(Timeout &&other) noexcept = delete;
-  auto operator=(Timeout const &other) -> Timeout & = delete;
-  auto operator=(Timeout &&other) noexcept -> Timeout & = delete;
-
-  explicit Timeout(
-    waypoint::TestId const test_id,
-    unsigned long long const timeout_ms,
-    std::mutex &transmission_mutex,
-    waypoint::internal::InputPipeEnd const &response_write_pipe)
-    : transmission_mutex_{transmission_mutex},
-      response_write_pipe_{response_write_pipe},
-      test_id_{test_id},
-      timeout_ms_{timeout_ms},
-      latch_{2},
-      is_armed_{true},
-      thread_{[this]()
-              {
-                this->latch_arrive_and_wait();
-
-                std::unique_lock lock{this->transmission_mutex_};
-
-                bool const disarmed = this->cv_.wait_for(
-                  lock,
-                  std::chrono::milliseconds{this->timeout_ms_},
-                  [this]()
-                  {
-                    return !this->is_armed_.load();
-                  });
-
-                if(disarmed)
-                {
-                  return;
-                }
-
-                send_timeout(this->response_write_pipe_, this->test_id_);
-
-                waypoint::coverage::gcov_dump();
-
-                // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_START
-                std::abort();
-                // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_STOP
-              }}
-  {
-    this->latch_arrive_and_wait();
-  }
-
-  void disarm()
-  {
-    std::lock_guard const lock{this->transmission_mutex_};
-
-    this->is_armed_.store(false);
-    this->cv_.notify_one();
-  }
-
-private:
-  void latch_arrive_and_wait()
-  {
-    // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_BR_START
-    this->latch_.arrive_and_wait();
-    // GCOV_COVERAGE_58QuSuUgMN8onvKx_EXCL_BR_STOP
-  }
+} // namespace waypoint::internal
 
-  std::mutex &transmission_mutex_;
-  waypoint::internal::InputPipeEnd const &response_write_pipe_;
-  unsigned long long test_id_;
-  unsigned long long timeout_ms_;
-  std::latch latch_;
-  std::condition_variable cv_;
-  std::atomic<bool> is_armed_;
-  std::thread thread_;
-};
+namespace
+{
 
 void populate_test_indices_(waypoint::TestRun const &t)
 {
@@ -188,11 +99,12 @@ void populate_test_indices_(waypoint::TestRun const &t)
   }
 }
 
-void run_test(
+// Returns the wall time of the test in microseconds
+auto run_test(
   waypoint::TestRun const &t,
   unsigned long long const test_index,
-  waypoint::internal::InputPipeEnd const &response_write_pipe,
-  std::mutex &transmission_mutex) noexcept
+  waypoint::internal::ResponseWriter &response_writer,
+  std::mutex &transmission_mutex) noexcept -> unsigned long long
 {
   auto const &impl = waypoint::internal::get_impl(t);
   waypoint::internal::TestRecord *const record =
@@ -202,45 +114,37 @@ void run_test(
 
   auto const ctx = impl.make_child_process_context(
     test_id,
-    response_write_pipe,
+    response_writer,
     transmission_mutex);
 
-  auto const timeout_ms = record->timeout_ms();
-  if(timeout_ms == 0)
-  {
-    record->test_assembly()(*ctx);
-  }
-  else
+  // Built before the test is stamped as started, so they do not count
+  // towards its timeout
+  auto const group_id = impl.get_group_id(test_id);
+  if(impl.has_unbuilt_group_fixtures(group_id))
   {
-    Timeout timeout{
-      test_id,
-      timeout_ms,
-      transmission_mutex,
-      response_write_pipe};
-    record->test_assembly()(*ctx);
-    timeout.disarm();
+    impl.build_group_fixtures(group_id);
   }
+
+  // Timeouts are enforced by the process waiting for this one,
+  // which kills it
+  response_writer.note_test_started(test_index);
+  auto const start = std::chrono::steady_clock::now();
+  record->test_assembly()(*ctx);
+  auto const end = std::chrono::steady_clock::now();
   record->mark_as_run();
-}
 
-void execute_command(
-  waypoint::TestRun const &t,
-  waypoint::internal::Command const &command,
-  waypoint::internal::InputPipeEnd const &response_write_pipe,
-  std::mutex &transmission_mutex)
-{
-  if(command.code == waypoint::internal::Command::Code::RunTest)
-  {
-    run_test(t, command.test_index, response_write_pipe, transmission_mutex);
-  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+    .count();
 }
 
 void begin_handshake(waypoint::internal::InputPipeEnd const &pipe)
 {
-  constexpr auto cmd =
-    std::to_underlying(waypoint::internal::Command::Code::Attention);
+  auto const frame = waypoint::internal::encode_command(
+    waypoint::internal::Command{
+      waypoint::internal::Command::Code::Attention,
+      {}});
 
-  pipe.write(&cmd, sizeof cmd);
+  pipe.write(frame.data(), frame.size());
 }
 
 void await_handshake_start(
@@ -249,28 +153,30 @@ void await_handshake_start(
 {
   std::lock_guard const lock{transmission_mutex};
 
-  unsigned char data = 0;
+  std::vector<unsigned char> payload;
   [[maybe_unused]]
-  auto const read_result = pipe.read(&data, sizeof data);
+  auto const read_result = pipe.read_frame(payload);
 }
 
 void complete_handshake(
-  waypoint::internal::InputPipeEnd const &pipe,
+  waypoint::internal::ResponseWriter &response_writer,
   std::mutex &transmission_mutex)
 {
   std::lock_guard const lock{transmission_mutex};
 
-  constexpr auto ready =
-    std::to_underlying(waypoint::internal::Response::Code::Ready);
-
-  pipe.write(&ready, sizeof ready);
+  response_writer.send(waypoint::internal::Response{
+    waypoint::internal::Response::Code::Ready,
+    {},
+    {},
+    {},
+    {}});
 }
 
-void await_handshake_end(waypoint::internal::OutputPipeEnd const &pipe)
+void await_handshake_end(waypoint::internal::ChildProcess const &child)
 {
-  unsigned char data = 0;
+  std::vector<unsigned char> payload;
   [[maybe_unused]]
-  auto const read_result = pipe.read(&data, sizeof data);
+  auto const read_result = child.read_response_frame(payload);
 }
 
 auto receive_command(
@@ -279,133 +185,135 @@ auto receive_command(
 {
   std::lock_guard const lock{transmission_mutex};
 
-  auto code_ = std::to_underlying(waypoint::internal::Command::Code::Invalid);
-  [[maybe_unused]]
-  auto read_result = command_read_pipe.read(&code_, sizeof code_);
-
-  auto const code = static_cast<waypoint::internal::Command::Code>(code_);
-
-  if(code == waypoint::internal::Command::Code::RunTest)
+  std::vector<unsigned char> payload;
+  auto const read_result = command_read_pipe.read_frame(payload);
+  if(read_result == waypoint::internal::OutputPipeEnd::ReadResult::PipeClosed)
   {
-    unsigned long long test_index = 0;
-    read_result = command_read_pipe.read(
-      reinterpret_cast<unsigned char *>(&test_index),
-      sizeof test_index);
-
-    return {code, test_index};
+    // The parent is gone, nobody is left to send further commands
+    return {waypoint::internal::Command::Code::End, {}};
   }
 
-  return {code, {}};
+  return waypoint::internal::decode_command(payload);
 }
 
-auto receive_response(
-  waypoint::internal::OutputPipeEnd const &response_read_pipe)
+auto receive_response(waypoint::internal::ChildProcess const &child)
   -> std::optional<waypoint::internal::Response>
 {
-  auto code_ = std::to_underlying(waypoint::internal::Response::Code::Invalid);
-  [[maybe_unused]]
-  auto read_result = response_read_pipe.read(&code_, sizeof code_);
+  std::vector<unsigned char> payload;
+  auto const read_result = child.read_response_frame(payload);
   if(read_result == waypoint::internal::OutputPipeEnd::ReadResult::PipeClosed)
   {
     return std::nullopt;
   }
 
-  auto const code = static_cast<waypoint::internal::Response::Code>(code_);
-
-  if(
-    code != waypoint::internal::Response::Code::Assertion &&
-    code != waypoint::internal::Response::Code::TestComplete &&
-    code != waypoint::internal::Response::Code::Timeout)
-  {
-    return {waypoint::internal::Response{code, {}, {}, {}, {}}};
-  }
-
-  unsigned long long test_id = 0;
-  read_result = response_read_pipe.read(
-    reinterpret_cast<unsigned char *>(&test_id),
-    sizeof test_id);
-
-  if(
-    code == waypoint::internal::Response::Code::TestComplete ||
-    code == waypoint::internal::Response::Code::Timeout)
-  {
-    return {waypoint::internal::Response{code, test_id, {}, {}, {}}};
-  }
-
-  unsigned char passed = 0;
-  read_result = response_read_pipe.read(&passed, sizeof passed);
-
-  unsigned long long assertion_index = 0;
-  read_result = response_read_pipe.read(
-    reinterpret_cast<unsigned char *>(&assertion_index),
-    sizeof assertion_index);
-
-  unsigned char has_message = 0;
-  read_result = response_read_pipe.read(&has_message, sizeof has_message);
-  if(has_message == 0)
-  {
-    return {waypoint::internal::Response{
-      code,
-      test_id,
-      passed == 1,
-      assertion_index,
-      std::nullopt}};
-  }
-
-  unsigned long long message_size = 0;
-  read_result = response_read_pipe.read(
-    reinterpret_cast<unsigned char *>(&message_size),
-    sizeof message_size);
-
-  std::string message(message_size, 'X');
-  read_result = response_read_pipe.read(
-    reinterpret_cast<unsigned char *>(message.data()),
-    message_size);
-
-  return {waypoint::internal::Response{
-    code,
-    test_id,
-    passed == 1,
-    assertion_index,
-    {message}}};
+  return {waypoint::internal::decode_response(payload)};
 }
 
 void send_command(
   waypoint::internal::InputPipeEnd const &command_write_pipe,
   waypoint::internal::Command const &command)
 {
-  auto const code = std::to_underlying(command.code);
-  command_write_pipe.write(&code, sizeof code);
-  if(command.code == waypoint::internal::Command::Code::RunTest)
-  {
-    auto const test_index = command.test_index;
-    command_write_pipe.write(
-      reinterpret_cast<unsigned char const *>(&test_index),
-      sizeof test_index);
-  }
+  auto const frame = waypoint::internal::encode_command(command);
+  command_write_pipe.write(frame.data(), frame.size());
 }
 
 void send_response(
   waypoint::TestRun const &t,
-  waypoint::internal::InputPipeEnd const &response_write_pipe,
+  waypoint::internal::ResponseWriter &response_writer,
   unsigned long long const test_index,
-  waypoint::internal::Response::Code const &code_,
+  waypoint::internal::Response::Code const &code,
+  unsigned long long const duration_us,
   std::mutex &transmission_mutex)
 {
   std::lock_guard const lock{transmission_mutex};
 
-  auto const code = std::to_underlying(code_);
-  response_write_pipe.write(&code, sizeof code);
-  if(code_ == waypoint::internal::Response::Code::TestComplete)
+  unsigned long long test_id = 0;
+  if(code == waypoint::internal::Response::Code::TestComplete)
   {
     waypoint::internal::TestRecord const *const record =
       waypoint::internal::get_impl(t).get_shuffled_test_record_ptrs().at(
         test_index);
-    auto const test_id = record->test_id();
-    response_write_pipe.write(
-      reinterpret_cast<unsigned char const *>(&test_id),
-      sizeof test_id);
+    test_id = record->test_id();
+  }
+
+  waypoint::internal::Response response{code, test_id, {}, {}, {}};
+  response.duration_us = duration_us;
+
+  response_writer.send(response);
+}
+
+void run_isolated_test(
+  waypoint::TestRun const &t,
+  unsigned long long const test_index,
+  waypoint::internal::ResponseWriter &response_writer,
+  std::mutex &transmission_mutex) noexcept
+{
+  auto const &impl = waypoint::internal::get_impl(t);
+  waypoint::internal::TestRecord const *const record =
+    impl.get_shuffled_test_record_ptrs().at(test_index);
+
+  // Built before forking, so that the forked process inherits
+  // a copy-on-write snapshot and the worker keeps the pristine value
+  impl.build_group_fixtures(impl.get_group_id(record->test_id()));
+
+  // The forked process is waited for with the test's timeout, so
+  // isolated tests time out without costing the worker its process
+  auto const maybe_exit_status = waypoint::internal::run_in_forked_process(
+    [&t, test_index, &response_writer, &transmission_mutex]()
+    {
+      auto const duration_us =
+        run_test(t, test_index, response_writer, transmission_mutex);
+      send_response(
+        t,
+        response_writer,
+        test_index,
+        waypoint::internal::Response::Code::TestComplete,
+        duration_us,
+        transmission_mutex);
+    },
+    record->timeout_ms());
+
+  // Also flushes whatever the forked process staged before it died
+  waypoint::internal::Response response{
+    maybe_exit_status.has_value()
+      ? waypoint::internal::Response::Code::TestExited
+      : waypoint::internal::Response::Code::Timeout,
+    record->test_id(),
+    {},
+    {},
+    {}};
+  response.exit_status = maybe_exit_status.value_or(0);
+
+  std::lock_guard const lock{transmission_mutex};
+  response_writer.send(response);
+}
+
+// Returns the wall time of a test run in this process, zero otherwise
+auto execute_command(
+  waypoint::TestRun const &t,
+  waypoint::internal::Command const &command,
+  waypoint::internal::ResponseWriter &response_writer,
+  std::mutex &transmission_mutex) -> unsigned long long
+{
+  if(command.code == waypoint::internal::Command::Code::RunTest)
+  {
+    return run_test(
+      t,
+      command.test_index,
+      response_writer,
+      transmission_mutex);
+  }
+
+  if(command.code == waypoint::internal::Command::Code::RunIsolatedTest)
+  {
+    run_isolated_test(
+      t,
+      command.test_index,
+      response_writer,
+      transmission_mutex);
   }
+
+  return 0;
 }
 
 auto is_end_command(waypoint::internal::Command const &command) -> bool
@@ -415,129 +323,1256 @@ auto is_end_command(waypoint::internal::Command const &command) -> bool
 
 void shut_down_sequence(
   waypoint::internal::InputPipeEnd const &command_write_pipe,
-  waypoint::internal::OutputPipeEnd const &response_read_pipe) noexcept
+  waypoint::internal::ChildProcess const &child) noexcept
 {
   constexpr auto command =
     waypoint::internal::Command{waypoint::internal::Command::Code::End, {}};
 
-  send_command(command_write_pipe, command);
+  send_command(command_write_pipe, command);
+
+  [[maybe_unused]]
+  auto const maybe_response = receive_response(child);
+}
+
+class Worker
+{
+public:
+  [[nodiscard]]
+  auto is_alive() const -> bool
+  {
+    return static_cast<bool>(this->child_);
+  }
+
+  [[nodiscard]]
+  auto is_busy() const -> bool
+  {
+    return !this->in_flight_.empty();
+  }
+
+  [[nodiscard]]
+  auto in_flight_count() const -> unsigned long long
+  {
+    return this->in_flight_.size();
+  }
+
+  // The child has been dispatched all the tests it can count and must
+  // be replaced once it finishes them
+  [[nodiscard]]
+  auto is_spent() const -> bool
+  {
+    return this->dispatched_count_ >= waypoint::internal::MAX_TESTS_PER_CHILD;
+  }
+
+  [[nodiscard]]
+  auto running_record() const -> waypoint::internal::TestRecord *
+  {
+    return this->in_flight_.front();
+  }
+
+  [[nodiscard]]
+  auto child() const -> waypoint::internal::ChildProcess const &
+  {
+    return *this->child_;
+  }
+
+  void spawn(
+    waypoint::internal::Transport const transport,
+    waypoint::internal::Zygote const *const zygote,
+    waypoint::internal::ReadOnlyRegion const *const shared_data)
+  {
+    auto child = std::make_unique<waypoint::internal::ChildProcess>(
+      transport,
+      zygote,
+      shared_data);
+    begin_handshake(child->command_write_pipe());
+
+    this->adopt(std::move(child));
+  }
+
+  // The child must have been sent the start of the handshake already
+  void adopt(std::unique_ptr<waypoint::internal::ChildProcess> child)
+  {
+    this->child_ = std::move(child);
+    this->dispatched_count_ = 0;
+
+    await_handshake_end(*this->child_);
+  }
+
+  void dispatch(
+    waypoint::internal::TestRecord *const record,
+    unsigned long long const test_index)
+  {
+    auto const command = waypoint::internal::Command{
+      record->isolated()
+        ? waypoint::internal::Command::Code::RunIsolatedTest
+        : waypoint::internal::Command::Code::RunTest,
+      test_index};
+    send_command(this->child_->command_write_pipe(), command);
+    record->mark_as_run();
+
+    this->in_flight_.push_back(record);
+    this->in_flight_positions_.push_back(this->dispatched_count_);
+    ++this->dispatched_count_;
+    if(this->in_flight_.size() == 1)
+    {
+      this->start_deadline();
+    }
+  }
+
+  // The group whose fixtures the child has built, or will build
+  // for a test dispatched to it
+  [[nodiscard]]
+  auto fixture_group() const -> std::optional<waypoint::GroupId>
+  {
+    return this->fixture_group_;
+  }
+
+  void note_fixture_group(waypoint::GroupId const group_id)
+  {
+    this->fixture_group_ = group_id;
+  }
+
+  void complete()
+  {
+    this->in_flight_.pop_front();
+    this->in_flight_positions_.pop_front();
+    this->last_assertion_index_.reset();
+    this->is_running_test_reported_ = false;
+    this->start_deadline();
+  }
+
+  // An isolated test stays in flight after it reports completion,
+  // until the child reports how its process exited
+  void note_running_test_reported()
+  {
+    this->is_running_test_reported_ = true;
+  }
+
+  // The deadline of the running test, which starts counting when the
+  // parent learns the previous test has finished
+  [[nodiscard]]
+  auto deadline() const -> std::optional<std::chrono::steady_clock::time_point>
+  {
+    return this->deadline_;
+  }
+
+  // Takes back the tests queued behind the running one, which the
+  // child has not claimed yet, and returns them in dispatch order.
+  // Positions of earlier revoked tests the child has yet to skip lie
+  // between those in flight, so each test's own position decides.
+  auto revoke_queued_tests() -> std::vector<waypoint::internal::TestRecord *>
+  {
+    auto const claimed_count =
+      this->child_->revoke_tests(this->dispatched_count_);
+    auto const kept_count = static_cast<unsigned long long>(
+      std::ranges::lower_bound(this->in_flight_positions_, claimed_count) -
+      this->in_flight_positions_.begin());
+
+    std::vector<waypoint::internal::TestRecord *> revoked{
+      this->in_flight_.begin() + static_cast<long long>(kept_count),
+      this->in_flight_.end()};
+    this->in_flight_.resize(kept_count);
+    this->in_flight_positions_.resize(kept_count);
+    if(kept_count == 0)
+    {
+      this->start_deadline();
+    }
+
+    return revoked;
+  }
+
+  // The deadline counts from when the parent learned the previous
+  // test had finished. Once it passes, it is moved to count from when
+  // the child actually started the test, which may have been later,
+  // or much later for a child that was just spawned.
+  void enforce_deadline(unsigned long long const running_test_index)
+  {
+    auto const now = std::chrono::steady_clock::now();
+    auto const timeout =
+      std::chrono::milliseconds{this->running_record()->timeout_ms()};
+
+    auto const started_at = this->child_->test_start_time(running_test_index);
+    if(started_at.has_value() && started_at.value() + timeout > now)
+    {
+      this->deadline_ = started_at.value() + timeout;
+
+      return;
+    }
+
+    // Group fixtures take as long as they take, and a test the child
+    // has not started yet has used none of its time
+    if(!started_at.has_value())
+    {
+      this->deadline_ = now + timeout;
+
+      return;
+    }
+
+    this->child_->kill();
+    this->timed_out_record_ = this->running_record();
+    this->deadline_.reset();
+  }
+
+  // Set once the running test has been killed for exceeding its
+  // timeout, until the child has been reaped
+  [[nodiscard]]
+  auto timed_out_record() const -> waypoint::internal::TestRecord *
+  {
+    return this->timed_out_record_;
+  }
+
+  [[nodiscard]]
+  auto is_running_test_reported() const -> bool
+  {
+    return this->is_running_test_reported_;
+  }
+
+  // Returns false for assertions received again, having been read
+  // from the staging area before the child flushed it
+  auto note_assertion(unsigned long long const assertion_index) -> bool
+  {
+    if(
+      this->last_assertion_index_.has_value() &&
+      assertion_index <= this->last_assertion_index_.value())
+    {
+      return false;
+    }
+
+    this->last_assertion_index_ = assertion_index;
+
+    return true;
+  }
+
+  // Assertions of the running test which the child staged but has
+  // not flushed, because it died or has not needed to yet. Those
+  // already received are skipped, as are those of a completed test
+  // that the child flushed but had not cleared yet. Only assertions
+  // following on from the last one received are taken, as earlier
+  // ones may still be on their way through the pipe.
+  [[nodiscard]]
+  auto unflushed_assertions() const
+    -> std::vector<waypoint::internal::Response>
+  {
+    auto const running_test_id = this->running_record()->test_id();
+    auto next_index = this->last_assertion_index_.has_value()
+      ? this->last_assertion_index_.value() + 1
+      : 0;
+
+    std::vector<waypoint::internal::Response> assertions;
+    for(auto const &payload : this->child_->staged_payloads())
+    {
+      auto response = waypoint::internal::decode_response(payload);
+      if(
+        response.code != waypoint::internal::Response::Code::Assertion ||
+        response.test_id != running_test_id ||
+        response.assertion_index < next_index)
+      {
+        continue;
+      }
+
+      if(response.assertion_index != next_index)
+      {
+        break;
+      }
+
+      assertions.push_back(std::move(response));
+      ++next_index;
+    }
+
+    return assertions;
+  }
+
+  // Tests queued behind the running one have not started yet
+  // and are handed back to be dispatched again. So is the running
+  // test if the one killed for its timeout managed to complete.
+  auto reap(std::deque<waypoint::internal::TestRecord *> &requeued)
+    -> unsigned long long
+  {
+    auto const exit_status = this->child_->wait();
+
+    this->child_.reset();
+    this->fixture_group_.reset();
+    this->last_assertion_index_.reset();
+    this->is_running_test_reported_ = false;
+    this->deadline_.reset();
+    if(
+      !this->in_flight_.empty() &&
+      (this->timed_out_record_ == nullptr ||
+       this->timed_out_record_ == this->in_flight_.front()))
+    {
+      this->in_flight_.pop_front();
+      this->in_flight_positions_.pop_front();
+    }
+    this->timed_out_record_ = nullptr;
+    requeued.insert(
+      requeued.begin(),
+      this->in_flight_.begin(),
+      this->in_flight_.end());
+    this->in_flight_.clear();
+    this->in_flight_positions_.clear();
+
+    return exit_status;
+  }
+
+  void shut_down()
+  {
+    shut_down_sequence(
+      this->child_->command_write_pipe(),
+      *this->child_);
+
+    std::deque<waypoint::internal::TestRecord *> requeued;
+    [[maybe_unused]]
+    auto const exit_status = this->reap(requeued);
+  }
+
+  // Kills the child, and with it the process of an isolated test it
+  // is running, without waiting for the tests in flight, which are
+  // then reported as not run and returned
+  auto cancel() -> std::vector<waypoint::internal::TestRecord *>
+  {
+    this->child_->kill();
+    std::vector<waypoint::internal::TestRecord *> cancelled{
+      this->in_flight_.begin(),
+      this->in_flight_.end()};
+    for(auto *const record : cancelled)
+    {
+      record->mark_as_not_run();
+    }
+
+    std::deque<waypoint::internal::TestRecord *> requeued;
+    [[maybe_unused]]
+    auto const exit_status = this->reap(requeued);
+
+    return cancelled;
+  }
+
+private:
+  void start_deadline()
+  {
+    this->deadline_.reset();
+    if(this->in_flight_.empty() || this->timed_out_record_ != nullptr)
+    {
+      return;
+    }
+
+    // Workers enforce the timeouts of isolated tests themselves
+    auto const *const record = this->in_flight_.front();
+    auto const timeout_ms = record->timeout_ms();
+    if(timeout_ms != 0 && !record->isolated())
+    {
+      this->deadline_ = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds{timeout_ms};
+    }
+  }
+
+  std::unique_ptr<waypoint::internal::ChildProcess> child_;
+  std::deque<waypoint::internal::TestRecord *> in_flight_;
+  // The position in the child's command sequence of each test in flight
+  std::deque<unsigned long long> in_flight_positions_;
+  std::optional<unsigned long long> last_assertion_index_;
+  std::optional<std::chrono::steady_clock::time_point> deadline_;
+  unsigned long long dispatched_count_{0};
+  std::optional<waypoint::GroupId> fixture_group_;
+  waypoint::internal::TestRecord *timed_out_record_{nullptr};
+  bool is_running_test_reported_{false};
+};
+
+void register_unflushed_assertions(
+  waypoint::internal::TestRun_impl &impl,
+  Worker &worker)
+{
+  for(auto const &assertion : worker.unflushed_assertions())
+  {
+    if(worker.note_assertion(assertion.assertion_index))
+    {
+      impl.register_assertion(
+        assertion.assertion_passed,
+        assertion.test_id,
+        assertion.assertion_index,
+        assertion.assertion_message);
+    }
+  }
+}
+
+// A test counts as started once its worker runs it, which is when
+// it is at the front of the worker's queue
+void report_running_test_started(
+  waypoint::internal::TestRun_impl &impl,
+  Worker const &worker)
+{
+  if(worker.is_busy() && worker.timed_out_record() == nullptr)
+  {
+    impl.report_test_started(worker.running_record()->test_id());
+  }
+}
+
+// Returns true once the running test has completed and failed
+auto handle_response(
+  waypoint::internal::TestRun_impl &impl,
+  Worker &worker,
+  std::deque<waypoint::internal::TestRecord *> &requeued) -> bool
+{
+  auto *const record = worker.running_record();
+  auto *const timed_out_record = worker.timed_out_record();
+
+  auto const maybe_response = receive_response(worker.child());
+  if(!maybe_response.has_value())
+  {
+    if(timed_out_record != nullptr && timed_out_record != record)
+    {
+      // The killed test completed in time after all, so the running
+      // one was only just started and is run again
+      [[maybe_unused]]
+      auto const exit_status = worker.reap(requeued);
+
+      return false;
+    }
+
+    register_unflushed_assertions(impl, worker);
+
+    auto const exit_status = worker.reap(requeued);
+    if(timed_out_record != nullptr)
+    {
+      record->mark_as_timed_out();
+      record->set_duration_us(record->timeout_ms() * 1'000);
+    }
+    else
+    {
+      record->mark_as_crashed();
+      impl.register_crashed_exit_status(record->test_id(), exit_status);
+    }
+    impl.report_test_finished(record->test_id());
+
+    return true;
+  }
+
+  // A killed child's tests behind the killed one are run again from
+  // the start, so nothing they reported meanwhile is kept
+  if(timed_out_record != nullptr && timed_out_record != record)
+  {
+    return false;
+  }
+
+  auto const &response = maybe_response.value();
+  if(
+    response.code == waypoint::internal::Response::Code::Assertion &&
+    worker.note_assertion(response.assertion_index))
+  {
+    impl.register_assertion(
+      response.assertion_passed,
+      response.test_id,
+      response.assertion_index,
+      response.assertion_message);
+  }
+
+  // Only isolated tests, whose worker kills their forked process
+  if(response.code == waypoint::internal::Response::Code::Timeout)
+  {
+    record->mark_as_timed_out();
+    record->set_duration_us(record->timeout_ms() * 1'000);
+    worker.complete();
+    impl.report_test_finished(record->test_id());
+    report_running_test_started(impl, worker);
+
+    return true;
+  }
+
+  if(response.code == waypoint::internal::Response::Code::TestComplete)
+  {
+    record->set_duration_us(response.duration_us);
+    if(record->isolated())
+    {
+      worker.note_running_test_reported();
+
+      return false;
+    }
+
+    worker.complete();
+    impl.report_test_finished(record->test_id());
+    report_running_test_started(impl, worker);
+
+    return impl.has_failing_assertions(record->test_id());
+  }
+
+  if(response.code == waypoint::internal::Response::Code::TestExited)
+  {
+    auto const is_crashed = !worker.is_running_test_reported();
+    if(is_crashed)
+    {
+      record->mark_as_crashed();
+      impl.register_crashed_exit_status(
+        record->test_id(),
+        response.exit_status);
+    }
+
+    worker.complete();
+    impl.report_test_finished(record->test_id());
+    report_running_test_started(impl, worker);
+
+    return is_crashed || impl.has_failing_assertions(record->test_id());
+  }
+
+  return false;
+}
+
+auto to_internal_transport(waypoint::RunConfig::Transport const transport)
+  -> waypoint::internal::Transport
+{
+  switch(transport)
+  {
+  case waypoint::RunConfig::Transport::Pipe:
+    return waypoint::internal::Transport::Pipe;
+  case waypoint::RunConfig::Transport::SharedMemory:
+    return waypoint::internal::Transport::SharedMemory;
+  }
+
+  std::unreachable();
+}
+
+// A child started ahead of time to replace one lost to a crash
+// or a timeout. It starts up and handshakes while tests run.
+class StandbyChild
+{
+public:
+  [[nodiscard]]
+  auto is_warm() const -> bool
+  {
+    return static_cast<bool>(this->child_);
+  }
+
+  void warm_up(
+    waypoint::internal::Transport const transport,
+    waypoint::internal::Zygote const *const zygote,
+    waypoint::internal::ReadOnlyRegion const *const shared_data)
+  {
+    this->child_ = std::make_unique<waypoint::internal::ChildProcess>(
+      transport,
+      zygote,
+      shared_data);
+
+    begin_handshake(this->child_->command_write_pipe());
+  }
+
+  [[nodiscard]]
+  auto take() -> std::unique_ptr<waypoint::internal::ChildProcess>
+  {
+    return std::move(this->child_);
+  }
+
+  void shut_down()
+  {
+    await_handshake_end(*this->child_);
+    shut_down_sequence(
+      this->child_->command_write_pipe(),
+      *this->child_);
+
+    [[maybe_unused]]
+    auto const exit_status = this->child_->wait();
+    this->child_.reset();
+  }
+
+private:
+  std::unique_ptr<waypoint::internal::ChildProcess> child_;
+};
+
+// Called once every test has been handed out. Tests queued behind the
+// running one on the busiest worker are spread over the idle workers
+// that are still alive, so the run does not wait on a single queue.
+// Spawning a child for a steal would cost more than it saves.
+void steal_queued_tests(
+  waypoint::internal::TestRun_impl const &impl,
+  std::vector<Worker> &workers,
+  unsigned long long const pipeline_depth,
+  std::deque<waypoint::internal::TestRecord *> &requeued)
+{
+  std::vector<Worker *> idle_workers;
+  for(auto &worker : workers)
+  {
+    if(worker.is_alive() && !worker.is_busy())
+    {
+      idle_workers.push_back(&worker);
+    }
+  }
+
+  auto const queued_count = [](Worker const &worker) -> unsigned long long
+  {
+    // A killed child's queue is requeued when it is reaped
+    if(!worker.is_busy() || worker.timed_out_record() != nullptr)
+    {
+      return 0;
+    }
+
+    return worker.in_flight_count() - 1;
+  };
+
+  auto const victim = std::ranges::max_element(workers, {}, queued_count);
+  if(idle_workers.empty() || queued_count(*victim) == 0)
+  {
+    return;
+  }
+
+  auto const revoked = victim->revoke_queued_tests();
+  auto const handed_out_count = std::min<unsigned long long>(
+    revoked.size(),
+    idle_workers.size() * pipeline_depth);
+  for(unsigned long long i = 0; i < handed_out_count; ++i)
+  {
+    auto *const record = revoked[i];
+    idle_workers[i % idle_workers.size()]->dispatch(
+      record,
+      impl.get_test_index(record->test_id()));
+  }
+
+  requeued.insert(
+    requeued.begin(),
+    revoked.begin() + static_cast<long long>(handed_out_count),
+    revoked.end());
+}
+
+auto get_durations_key(
+  waypoint::internal::TestRun_impl const &impl,
+  waypoint::internal::TestRecord const *const record)
+  -> std::pair<std::string, std::string>
+{
+  auto const test_id = record->test_id();
+
+  return {
+    std::string{impl.get_group_name(impl.get_group_id(test_id))},
+    std::string{impl.get_test_name(test_id)}};
+}
+
+// Tests known to take longest start first so that they do not end up
+// alone at the tail of the run. Tests without a recorded duration
+// follow in shuffled order.
+auto schedule_longest_first(
+  waypoint::internal::TestRun_impl &impl,
+  waypoint::internal::TestDurations const &durations)
+  -> std::vector<waypoint::internal::TestRecord *>
+{
+  std::vector<std::pair<unsigned long long, waypoint::internal::TestRecord *>>
+    known;
+  std::vector<waypoint::internal::TestRecord *> unknown;
+  for(auto *const record : impl.get_shuffled_test_record_ptrs())
+  {
+    auto const it = durations.find(get_durations_key(impl, record));
+    if(it == durations.end())
+    {
+      unknown.push_back(record);
+    }
+    else
+    {
+      known.emplace_back(it->second, record);
+    }
+  }
+
+  std::ranges::stable_sort(
+    known,
+    std::ranges::greater{},
+    [](auto const &entry)
+    {
+      return entry.first;
+    });
+
+  std::vector<waypoint::internal::TestRecord *> schedule;
+  schedule.reserve(known.size() + unknown.size());
+  for(auto const &entry : known)
+  {
+    schedule.push_back(entry.second);
+  }
+  schedule.insert(schedule.end(), unknown.begin(), unknown.end());
+
+  return schedule;
+}
+
+void record_durations(
+  waypoint::internal::TestRun_impl &impl,
+  std::string const &path)
+{
+  waypoint::internal::TestDurations durations;
+  for(auto const *const record : impl.get_shuffled_test_record_ptrs())
+  {
+    auto const duration_us = record->duration_us();
+    if(duration_us.has_value())
+    {
+      durations.emplace(get_durations_key(impl, record), duration_us.value());
+    }
+  }
+
+  waypoint::internal::update_timing_database(path, durations);
+}
+
+// Hands out the scheduled tests in order, except that a worker keeps
+// getting the tests of the group whose fixtures its child has built,
+// and otherwise avoids groups whose fixtures other workers have built
+class Backlog
+{
+public:
+  Backlog(
+    waypoint::internal::TestRun_impl const &impl,
+    std::vector<waypoint::internal::TestRecord *> const &schedule)
+  {
+    for(auto *const record : schedule)
+    {
+      if(record->disabled() || !record->in_shard())
+      {
+        continue;
+      }
+
+      auto const group_id = impl.get_group_id(record->test_id());
+      if(impl.has_group_fixtures(group_id))
+      {
+        this->fixture_group_positions_[group_id].push_back(
+          this->records_.size());
+        this->fixture_groups_.emplace_back(group_id);
+      }
+      else
+      {
+        this->fixture_groups_.emplace_back(std::nullopt);
+      }
+      this->records_.push_back(record);
+    }
+
+    this->is_taken_.resize(this->records_.size(), false);
+  }
+
+  [[nodiscard]]
+  auto empty() const -> bool
+  {
+    return this->taken_count_ == this->records_.size();
+  }
+
+  [[nodiscard]]
+  auto fixture_group(unsigned long long const position) const
+    -> std::optional<waypoint::GroupId>
+  {
+    return this->fixture_groups_[position];
+  }
+
+  // Returns the position of the next test for a worker, or
+  // std::nullopt if none are left
+  auto take(
+    std::optional<waypoint::GroupId> const &preferred_group,
+    std::vector<waypoint::GroupId> const &avoided_groups)
+    -> std::optional<unsigned long long>
+  {
+    if(preferred_group.has_value())
+    {
+      auto &positions =
+        this->fixture_group_positions_[preferred_group.value()];
+      while(!positions.empty() && this->is_taken_[positions.front()])
+      {
+        positions.pop_front();
+      }
+
+      if(!positions.empty())
+      {
+        return this->mark_taken(positions.front());
+      }
+    }
+
+    while(this->next_ < this->records_.size() &&
+          this->is_taken_[this->next_])
+    {
+      ++this->next_;
+    }
+
+    if(this->next_ == this->records_.size())
+    {
+      return std::nullopt;
+    }
+
+    for(auto position = this->next_; position < this->records_.size();
+        ++position)
+    {
+      auto const &group_id = this->fixture_groups_[position];
+      if(
+        !this->is_taken_[position] &&
+        (!group_id.has_value() ||
+         std::ranges::find(avoided_groups, group_id.value()) ==
+           avoided_groups.end()))
+      {
+        return this->mark_taken(position);
+      }
+    }
+
+    return this->mark_taken(this->next_);
+  }
+
+  [[nodiscard]]
+  auto record(unsigned long long const position) const
+    -> waypoint::internal::TestRecord *
+  {
+    return this->records_[position];
+  }
+
+private:
+  auto mark_taken(unsigned long long const position) -> unsigned long long
+  {
+    this->is_taken_[position] = true;
+    ++this->taken_count_;
+
+    return position;
+  }
+
+  std::vector<waypoint::internal::TestRecord *> records_;
+  std::vector<std::optional<waypoint::GroupId>> fixture_groups_;
+  std::vector<bool> is_taken_;
+  std::unordered_map<waypoint::GroupId, std::deque<unsigned long long>>
+    fixture_group_positions_;
+  unsigned long long next_{0};
+  unsigned long long taken_count_{0};
+};
+
+void parent_main(
+  waypoint::TestRun const &t,
+  std::vector<waypoint::internal::TestRecord *> const &schedule,
+  unsigned long long const worker_count,
+  unsigned long long const pipeline_depth,
+  waypoint::internal::Transport const transport,
+  waypoint::internal::Zygote const *const zygote,
+  bool const isolate_all_tests,
+  unsigned long long const max_failures,
+  std::chrono::milliseconds const flush_interval) noexcept
+{
+  auto &impl = waypoint::internal::get_impl(t);
+
+  Backlog backlog{impl, schedule};
+  std::deque<waypoint::internal::TestRecord *> requeued;
+
+  for(auto *const record : schedule)
+  {
+    // Every test of a snapshot fixture's group runs in its own fork
+    if(
+      isolate_all_tests ||
+      impl.has_snapshot_fixtures(impl.get_group_id(record->test_id())))
+    {
+      record->isolate();
+    }
+  }
+
+  std::vector<Worker> workers(worker_count);
+
+  auto const take_next_record =
+    [&backlog, &requeued, &workers](Worker &worker)
+    -> waypoint::internal::TestRecord *
+  {
+    if(!requeued.empty())
+    {
+      auto *const record = requeued.front();
+      requeued.pop_front();
+
+      return record;
+    }
+
+    std::vector<waypoint::GroupId> avoided_groups;
+    for(auto const &other : workers)
+    {
+      if(&other != &worker && other.fixture_group().has_value())
+      {
+        avoided_groups.push_back(other.fixture_group().value());
+      }
+    }
+
+    auto const position = backlog.take(worker.fixture_group(), avoided_groups);
+    if(!position.has_value())
+    {
+      return nullptr;
+    }
+
+    auto const fixture_group = backlog.fixture_group(position.value());
+    if(fixture_group.has_value())
+    {
+      worker.note_fixture_group(fixture_group.value());
+    }
+
+    return backlog.record(position.value());
+  };
+  StandbyChild standby;
+  bool is_child_lost = false;
+  unsigned long long failure_count = 0;
+  std::optional<std::chrono::steady_clock::time_point> next_flush;
+
+  while(true)
+  {
+    for(auto &worker : workers)
+    {
+      while(worker.in_flight_count() < pipeline_depth)
+      {
+        if(worker.is_alive() && worker.is_spent())
+        {
+          if(worker.is_busy())
+          {
+            break;
+          }
+
+          worker.shut_down();
+        }
+
+        auto *const record = take_next_record(worker);
+        if(record == nullptr)
+        {
+          break;
+        }
+
+        if(!worker.is_alive())
+        {
+          if(standby.is_warm())
+          {
+            worker.adopt(standby.take());
+          }
+          else
+          {
+            worker.spawn(transport, zygote, impl.shared_data_region());
+          }
+        }
+
+        worker.dispatch(record, impl.get_test_index(record->test_id()));
+        report_running_test_started(impl, worker);
+      }
+    }
+
+    steal_queued_tests(impl, workers, pipeline_depth, requeued);
+
+    std::vector<Worker *> busy_workers;
+    std::vector<waypoint::internal::ChildProcess const *> children;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    for(auto &worker : workers)
+    {
+      if(worker.is_busy())
+      {
+        busy_workers.push_back(&worker);
+        children.push_back(&worker.child());
+
+        auto const worker_deadline = worker.deadline();
+        if(
+          worker_deadline.has_value() &&
+          (!deadline.has_value() || worker_deadline < deadline))
+        {
+          deadline = worker_deadline;
+        }
+      }
+    }
+
+    if(busy_workers.empty())
+    {
+      break;
+    }
+
+    // Children only flush their staged assertions when a test ends or
+    // the staging area fills up, so the parent also wakes up to read
+    // what they staged, however long their tests run
+    if(flush_interval.count() > 0)
+    {
+      if(!next_flush.has_value())
+      {
+        next_flush = std::chrono::steady_clock::now() + flush_interval;
+      }
+
+      if(!deadline.has_value() || next_flush < deadline)
+      {
+        deadline = next_flush;
+      }
+    }
+
+    for(auto const i :
+        waypoint::internal::wait_for_readable(children, deadline))
+    {
+      auto &worker = *busy_workers[i];
+      do
+      {
+        if(handle_response(impl, worker, requeued))
+        {
+          ++failure_count;
+        }
+      } while(worker.is_busy() && worker.child().has_buffered_response());
+
+      // No more responses are awaited from a killed child
+      // whose tests all completed in time after all
+      if(worker.timed_out_record() != nullptr && !worker.is_busy())
+      {
+        [[maybe_unused]]
+        auto const exit_status = worker.reap(requeued);
+      }
+
+      is_child_lost = is_child_lost || !worker.is_alive();
+    }
+
+    // Tests not yet completed are left as not run
+    if(max_failures != 0 && failure_count >= max_failures)
+    {
+      for(auto &worker : workers)
+      {
+        if(worker.is_busy())
+        {
+          for(auto *const record : worker.cancel())
+          {
+            impl.report_test_finished(record->test_id());
+          }
+        }
+      }
+
+      for(auto *const record : requeued)
+      {
+        record->mark_as_not_run();
+        impl.report_test_finished(record->test_id());
+      }
+
+      break;
+    }
+
+    // The responses of a killed child end like after a crash
+    // and are handled in the next iteration
+    auto const now = std::chrono::steady_clock::now();
+    if(next_flush.has_value() && next_flush <= now)
+    {
+      for(auto *const worker : busy_workers)
+      {
+        if(worker->is_busy() && worker->timed_out_record() == nullptr)
+        {
+          register_unflushed_assertions(impl, *worker);
+        }
+      }
+
+      next_flush = now + flush_interval;
+    }
+
+    for(auto *const worker : busy_workers)
+    {
+      auto const worker_deadline = worker->deadline();
+      if(worker_deadline.has_value() && worker_deadline <= now)
+      {
+        worker->enforce_deadline(
+          impl.get_test_index(worker->running_record()->test_id()));
+      }
+    }
+
+    // Suites that crash once tend to crash again, so after the first
+    // lost child a replacement is kept ready while tests remain
+    if(
+      is_child_lost && !standby.is_warm() &&
+      (!requeued.empty() || !backlog.empty()))
+    {
+      standby.warm_up(transport, zygote, impl.shared_data_region());
+    }
+  }
+
+  if(standby.is_warm())
+  {
+    standby.shut_down();
+  }
 
-  [[maybe_unused]]
-  auto const maybe_response = receive_response(response_read_pipe);
+  for(auto &worker : workers)
+  {
+    if(worker.is_alive())
+    {
+      worker.shut_down();
+    }
+  }
 }
 
-auto parent_main(
+void child_main(
   waypoint::TestRun const &t,
-  waypoint::internal::InputPipeEnd const &command_write_pipe,
-  waypoint::internal::OutputPipeEnd const &response_read_pipe,
-  unsigned long long const initial_test_index) noexcept
-  -> std::tuple<waypoint::TestRunResult, bool, unsigned long long>
+  waypoint::internal::OutputPipeEnd const &command_read_pipe,
+  waypoint::internal::ResponseWriter &response_writer) noexcept
 {
-  begin_handshake(command_write_pipe);
-  await_handshake_end(response_read_pipe);
-
-  auto &impl = waypoint::internal::get_impl(t);
+  std::mutex transmission_mutex;
 
-  auto const &all_records = impl.get_shuffled_test_record_ptrs();
-  auto const record_subset = std::span(
-    all_records.data() + initial_test_index,
-    all_records.size() - initial_test_index);
+  await_handshake_start(command_read_pipe, transmission_mutex);
+  complete_handshake(response_writer, transmission_mutex);
 
-  for(auto *record : record_subset)
+  while(true)
   {
-    if(record->disabled())
+    auto const command = receive_command(command_read_pipe, transmission_mutex);
+
+    auto const is_test_command =
+      command.code == waypoint::internal::Command::Code::RunTest ||
+      command.code == waypoint::internal::Command::Code::RunIsolatedTest;
+    // The parent handed the test to another worker
+    if(is_test_command && !response_writer.claim_test())
     {
       continue;
     }
 
-    auto const test_index = impl.get_test_index(record->test_id());
+    auto const duration_us =
+      execute_command(t, command, response_writer, transmission_mutex);
 
-    auto const command = waypoint::internal::Command{
-      waypoint::internal::Command::Code::RunTest,
-      test_index};
-    send_command(command_write_pipe, command);
-    record->mark_as_run();
+    // Isolated tests have already been reported by run_isolated_test
+    if(command.code != waypoint::internal::Command::Code::RunIsolatedTest)
+    {
+      send_response(
+        t,
+        response_writer,
+        command.test_index,
+        std::invoke(
+          [&command]()
+          {
+            if(command.code == waypoint::internal::Command::Code::RunTest)
+            {
+              return waypoint::internal::Response::Code::TestComplete;
+            }
+
+            return waypoint::internal::Response::Code::ShuttingDown;
+          }),
+        duration_us,
+        transmission_mutex);
+    }
 
-    while(true)
+    if(is_end_command(command))
     {
-      auto const maybe_response = receive_response(response_read_pipe);
-      if(!maybe_response.has_value())
-      {
-        record->mark_as_crashed();
+      break;
+    }
+  }
+}
 
-        return {
-          impl.generate_results(),
-          true,
-          impl.get_test_index(record->test_id())};
-      }
+// Returns true if the test failed
+auto run_in_process_test(
+  waypoint::internal::TestRun_impl const &impl,
+  waypoint::internal::TestRecord *const record,
+  waypoint::internal::AssertionBuffer &assertion_buffer) -> bool
+{
+  auto const context =
+    impl.make_in_process_context(record->test_id(), &assertion_buffer);
 
-      auto const &response = maybe_response.value();
-      if(response.code == waypoint::internal::Response::Code::Assertion)
-      {
-        impl.register_assertion(
-          response.assertion_passed,
-          response.test_id,
-          response.assertion_index,
-          response.assertion_message);
-      }
+  auto const first_assertion = assertion_buffer.size();
+  record->test_assembly()(*context);
+  record->mark_as_run();
 
-      if(response.code == waypoint::internal::Response::Code::Timeout)
-      {
-        record->mark_as_timed_out();
+  // The next test of the group gets a freshly built value
+  impl.tear_down_snapshot_fixtures(impl.get_group_id(record->test_id()));
 
-        return {
-          impl.generate_results(),
-          true,
-          impl.get_test_index(record->test_id())};
-      }
+  return std::ranges::any_of(
+    assertion_buffer | std::ranges::views::drop(first_assertion),
+    [](auto const &entry)
+    {
+      return !entry.second.passed();
+    });
+}
 
-      if(response.code == waypoint::internal::Response::Code::TestComplete)
-      {
-        break;
-      }
-    }
+void register_assertions(
+  waypoint::internal::TestRun_impl &impl,
+  waypoint::internal::AssertionBuffer &assertion_buffer)
+{
+  for(auto &[test_id, assertion] : assertion_buffer)
+  {
+    impl.register_assertion(
+      assertion.passed(),
+      test_id,
+      assertion.index(),
+      assertion.message());
   }
 
-  shut_down_sequence(command_write_pipe, response_read_pipe);
-
-  return {impl.generate_results(), false, 0};
+  assertion_buffer.clear();
 }
 
-void child_main(
-  waypoint::TestRun const &t,
-  waypoint::internal::OutputPipeEnd const &command_read_pipe,
-  waypoint::internal::InputPipeEnd const &response_write_pipe) noexcept
+// Each thread buffers its own assertions, so they are registered
+// without contention once all threads are done. When streaming, each
+// test's assertions are registered as soon as it ends instead, one test
+// at a time, so that buffers stay small. Thread-unsafe tests,
+// and those sharing a snapshot fixture, run afterwards, one at a time,
+// with no other test running. No test starts once max_failures, unless
+// zero, have failed.
+void run_tests_on_threads(
+  waypoint::internal::TestRun_impl &impl,
+  unsigned long long const thread_count,
+  unsigned long long const max_failures)
 {
-  std::mutex transmission_mutex;
+  std::vector<waypoint::internal::TestRecord *> concurrent_records;
+  std::vector<waypoint::internal::TestRecord *> serial_records;
+  for(auto *const record : impl.get_shuffled_test_record_ptrs())
+  {
+    if(record->disabled() || !record->in_shard())
+    {
+      continue;
+    }
 
-  await_handshake_start(command_read_pipe, transmission_mutex);
-  complete_handshake(response_write_pipe, transmission_mutex);
+    if(
+      record->thread_unsafe() ||
+      impl.has_snapshot_fixtures(impl.get_group_id(record->test_id())))
+    {
+      serial_records.push_back(record);
+    }
+    else
+    {
+      concurrent_records.push_back(record);
+    }
+  }
 
-  while(true)
+  std::vector<waypoint::internal::AssertionBuffer> assertion_buffers(
+    thread_count);
+  std::atomic<unsigned long long> next_record{0};
+  std::atomic<unsigned long long> failure_count{0};
+  auto const is_stopped = [&failure_count, max_failures]()
   {
-    auto const command = receive_command(command_read_pipe, transmission_mutex);
+    return max_failures != 0 &&
+      failure_count.load(std::memory_order_relaxed) >= max_failures;
+  };
+  std::mutex stream_mutex;
+  auto const run_record =
+    [&impl, &failure_count, &stream_mutex](
+      waypoint::internal::TestRecord *const record,
+      waypoint::internal::AssertionBuffer &assertion_buffer)
+  {
+    if(impl.is_streaming())
+    {
+      std::scoped_lock const lock{stream_mutex};
+      impl.report_test_started(record->test_id());
+    }
 
-    execute_command(t, command, response_write_pipe, transmission_mutex);
-    send_response(
-      t,
-      response_write_pipe,
-      command.test_index,
-      std::invoke(
-        [&command]()
-        {
-          if(command.code == waypoint::internal::Command::Code::RunTest)
-          {
-            return waypoint::internal::Response::Code::TestComplete;
-          }
+    if(run_in_process_test(impl, record, assertion_buffer))
+    {
+      failure_count.fetch_add(1, std::memory_order_relaxed);
+    }
 
-          return waypoint::internal::Response::Code::ShuttingDown;
-        }),
-      transmission_mutex);
+    if(impl.is_streaming())
+    {
+      std::scoped_lock const lock{stream_mutex};
+      register_assertions(impl, assertion_buffer);
+      impl.report_test_finished(record->test_id());
+    }
+  };
+  auto const run_concurrent_records =
+    [&concurrent_records, &next_record, &is_stopped, &run_record](
+      waypoint::internal::AssertionBuffer &assertion_buffer)
+  {
+    while(!is_stopped())
+    {
+      auto const i = next_record.fetch_add(1, std::memory_order_relaxed);
+      if(i >= concurrent_records.size())
+      {
+        return;
+      }
 
-    if(is_end_command(command))
+      run_record(concurrent_records[i], assertion_buffer);
+    }
+  };
+
+  {
+    // The calling thread is one of the runners
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count - 1);
+    for(unsigned long long i = 1; i < thread_count; ++i)
+    {
+      threads.emplace_back(
+        run_concurrent_records,
+        std::ref(assertion_buffers[i]));
+    }
+
+    run_concurrent_records(assertion_buffers[0]);
+  }
+
+  for(auto *const record : serial_records)
+  {
+    if(is_stopped())
     {
       break;
     }
+
+    run_record(record, assertion_buffers[0]);
+  }
+
+  for(auto &assertion_buffer : assertion_buffers)
+  {
+    register_assertions(impl, assertion_buffer);
   }
 }
 
@@ -553,6 +1588,21 @@ void initialize(waypoint::TestRun const &t) noexcept
   populate_test_indices_(t);
 }
 
+void select_shard(
+  waypoint::internal::TestRun_impl &impl,
+  waypoint::internal::RunConfig_impl const &config)
+{
+  auto const &malformed_variable = config.malformed_shard_variable();
+  if(malformed_variable.has_value())
+  {
+    impl.report_malformed_shard(malformed_variable.value());
+
+    return;
+  }
+
+  impl.select_shard(config.shard_index(), config.shard_count());
+}
+
 } // namespace
 
 namespace waypoint
@@ -567,6 +1617,7 @@ auto run_all_tests_in_process(TestRun const &t) noexcept -> TestRunResult
     return internal::get_impl(t).generate_results();
   }
 
+  internal::get_impl(t).build_shared_data();
   std::ranges::for_each(
     internal::get_impl(t).get_shuffled_test_record_ptrs(),
     [&t](auto *const ptr) noexcept
@@ -574,18 +1625,61 @@ auto run_all_tests_in_process(TestRun const &t) noexcept -> TestRunResult
       if(!ptr->disabled())
       {
         auto const context =
-          internal::get_impl(t).make_in_process_context(ptr->test_id());
+          internal::get_impl(t).make_in_process_context(
+            ptr->test_id(),
+            nullptr);
 
         // Run test
         ptr->test_assembly()(*context);
         ptr->mark_as_run();
+
+        internal::get_impl(t).tear_down_snapshot_fixtures(
+          internal::get_impl(t).get_group_id(ptr->test_id()));
       }
     });
+  internal::get_impl(t).tear_down_group_fixtures();
 
   return internal::get_impl(t).generate_results();
 }
 
+auto run_all_tests_in_process(
+  TestRun const &t,
+  RunConfig const &config) noexcept -> TestRunResult
+{
+  initialize(t);
+  auto &impl = internal::get_impl(t);
+  if(impl.has_errors())
+  {
+    // Initialization had errors, skip running tests and emit results
+    return impl.generate_results();
+  }
+
+  select_shard(impl, internal::get_impl(config));
+  if(impl.has_errors())
+  {
+    return impl.generate_results();
+  }
+
+  impl.set_result_sink(internal::get_impl(config).result_sink());
+  impl.build_shared_data();
+  run_tests_on_threads(
+    impl,
+    internal::get_impl(config).worker_count(),
+    internal::get_impl(config).max_failures());
+  impl.tear_down_group_fixtures();
+
+  return impl.generate_results();
+}
+
 auto run_all_tests(TestRun const &t) noexcept -> TestRunResult
+{
+  RunConfig const config;
+
+  return run_all_tests(t, config);
+}
+
+auto run_all_tests(TestRun const &t, RunConfig const &config) noexcept
+  -> TestRunResult
 {
   initialize(t);
   auto &impl = internal::get_impl(t);
@@ -595,80 +1689,175 @@ auto run_all_tests(TestRun const &t) noexcept -> TestRunResult
     return impl.generate_results();
   }
 
-  if(waypoint::internal::is_child())
+  select_shard(impl, internal::get_impl(config));
+  if(impl.has_errors())
+  {
+    return impl.generate_results();
+  }
+
+  auto const is_child = waypoint::internal::is_child();
+  auto const spawn_from_zygote = !is_child &&
+    internal::get_impl(config).spawn() == RunConfig::Spawn::Zygote;
+  auto const zygote = spawn_from_zygote ? waypoint::internal::start_zygote()
+                                        : std::nullopt;
+
+  // Workers forked from the zygote carry on from here
+  if(is_child || (spawn_from_zygote && waypoint::internal::is_child()))
   {
     {
       auto const pipes = waypoint::internal::get_pipes_from_env();
 
       auto const &command_read_pipe = pipes.first;
-      auto const &response_write_pipe = pipes.second;
-
-      child_main(t, command_read_pipe, response_write_pipe);
+      waypoint::internal::ResponseWriter response_writer{
+        pipes.second,
+        waypoint::internal::get_staging_area_from_env(),
+        waypoint::internal::get_response_ring_from_env()};
+
+      impl.adopt_shared_data(
+        waypoint::internal::get_read_only_region_from_env());
+      child_main(t, command_read_pipe, response_writer);
     }
 
+    impl.tear_down_group_fixtures();
+
     std::exit(0);
   }
 
-  unsigned long long initial_test_index = 0;
-  while(true)
+  impl.set_result_sink(internal::get_impl(config).result_sink());
+  impl.build_shared_data();
+
+  auto const &timing_database = internal::get_impl(config).timing_database();
+  auto const schedule = timing_database.has_value()
+    ? schedule_longest_first(
+        impl,
+        waypoint::internal::read_timing_database(timing_database.value()))
+    : impl.get_shuffled_test_record_ptrs();
+
+  parent_main(
+    t,
+    schedule,
+    internal::get_impl(config).worker_count(),
+    internal::get_impl(config).pipeline_depth(),
+    to_internal_transport(internal::get_impl(config).transport()),
+    zygote.has_value() ? &zygote.value() : nullptr,
+    internal::get_impl(config).isolation() == RunConfig::Isolation::PerTest,
+    internal::get_impl(config).max_failures(),
+    std::chrono::milliseconds{internal::get_impl(config).flush_interval_ms()});
+
+  if(timing_database.has_value())
   {
-    waypoint::internal::ChildProcess const child;
+    record_durations(impl, timing_database.value());
+  }
 
-    auto results = parent_main(
-      t,
-      child.command_write_pipe(),
-      child.response_read_pipe(),
-      initial_test_index);
-    auto run_result = std::move(std::get<0>(results));
-    auto const crash_or_timeout = std::get<1>(results);
-    auto const creshed_test_index = std::get<2>(results);
+  return impl.generate_results();
+}
 
-    auto const exit_status = child.wait();
+RunConfig::~RunConfig() = default;
 
-    if(!crash_or_timeout)
-    {
-      return run_result;
-    }
+RunConfig::RunConfig()
+  : impl_{internal::UniquePtr{new internal::RunConfig_impl{}}}
+{
+}
 
-    auto const *record =
-      impl.get_shuffled_test_record_ptrs().at(creshed_test_index);
-    if(record->status() == internal::TestRecord::Status::Terminated)
-    {
-      auto const crashed_test_id = record->test_id();
-      impl.register_crashed_exit_status(crashed_test_id, exit_status);
-    }
+auto RunConfig::workers(unsigned long long const count) noexcept -> RunConfig &
+{
+  this->impl_->set_worker_count(count);
 
-    initial_test_index = creshed_test_index + 1;
-  }
+  return *this;
+}
 
-  std::unreachable();
+auto RunConfig::pipeline_depth(unsigned long long const depth) noexcept
+  -> RunConfig &
+{
+  this->impl_->set_pipeline_depth(depth);
+
+  return *this;
+}
+
+auto RunConfig::flush_interval_ms(
+  unsigned long long const interval_ms) noexcept -> RunConfig &
+{
+  this->impl_->set_flush_interval_ms(interval_ms);
+
+  return *this;
+}
+
+auto RunConfig::transport(Transport const transport) noexcept -> RunConfig &
+{
+  this->impl_->set_transport(transport);
+
+  return *this;
+}
+
+auto RunConfig::spawn(Spawn const spawn) noexcept -> RunConfig &
+{
+  this->impl_->set_spawn(spawn);
+
+  return *this;
+}
+
+auto RunConfig::isolation(Isolation const isolation) noexcept -> RunConfig &
+{
+  this->impl_->set_isolation(isolation);
+
+  return *this;
+}
+
+auto RunConfig::timing_database(char const *const path) noexcept
+  -> RunConfig &
+{
+  this->impl_->set_timing_database(path);
+
+  return *this;
+}
+
+auto RunConfig::shard(
+  unsigned long long const index,
+  unsigned long long const count) noexcept -> RunConfig &
+{
+  this->impl_->set_shard(index, count);
+
+  return *this;
+}
+
+auto RunConfig::max_failures(unsigned long long const count) noexcept
+  -> RunConfig &
+{
+  this->impl_->set_max_failures(count);
+
+  return *this;
+}
+
+auto RunConfig::result_sink(ResultSink &sink) noexcept -> RunConfig &
+{
+  this->impl_->set_result_sink(&sink);
+
+  return *this;
 }
 
 AssertionOutcome::~AssertionOutcome() = default;
 
-AssertionOutcome::AssertionOutcome(internal::AssertionOutcome_impl *const impl)
-  : impl_{internal::UniquePtr{impl}}
+AssertionOutcome::AssertionOutcome(
+  TestOutcome const *const test_outcome,
+  internal::AssertionOutcome_impl const *const impl)
+  : test_outcome_{test_outcome},
+    impl_{impl}
 {
 }
 
 auto AssertionOutcome::group() const noexcept -> char const *
 {
-  return this->impl_->group_name();
+  return this->test_outcome_->group_name();
 }
 
 auto AssertionOutcome::test() const noexcept -> char const *
 {
-  return this->impl_->test_name();
+  return this->test_outcome_->test_name();
 }
 
 auto AssertionOutcome::message() const noexcept -> char const *
 {
-  if(this->impl_->message().has_value())
-  {
-    return this->impl_->message().value().c_str();
-  }
-
-  return nullptr;
+  return this->impl_->message();
 }
 
 auto AssertionOutcome::passed() const noexcept -> bool
@@ -690,12 +1879,12 @@ TestOutcome::TestOutcome(internal::TestOutcome_impl *const impl)
 
 auto TestOutcome::group_name() const noexcept -> char const *
 {
-  return this->impl_->get_group_name().c_str();
+  return this->impl_->get_group_name().data();
 }
 
 auto TestOutcome::test_name() const noexcept -> char const *
 {
-  return this->impl_->get_test_name().c_str();
+  return this->impl_->get_test_name().data();
 }
 
 auto TestOutcome::test_index() const noexcept -> unsigned long long
@@ -714,6 +1903,24 @@ auto TestOutcome::assertion_outcome(
   return this->impl_->get_assertion_outcome(index);
 }
 
+auto TestOutcome::failing_assertion_count() const noexcept
+  -> unsigned long long
+{
+  return this->impl_->get_failing_assertion_count();
+}
+
+auto TestOutcome::failing_assertion_outcome(
+  unsigned long long const index) const noexcept -> AssertionOutcome const &
+{
+  return this->impl_->get_failing_assertion_outcome(index);
+}
+
+auto TestOutcome::passing_assertion_count() const noexcept
+  -> unsigned long long
+{
+  return this->impl_->get_passing_assertion_count();
+}
+
 auto TestOutcome::disabled() const noexcept -> bool
 {
   return this->impl_->disabled();
@@ -737,6 +1944,33 @@ auto TestOutcome::exit_code() const noexcept -> unsigned long long const *
   return nullptr;
 }
 
+ResultSink::~ResultSink() = default;
+
+ResultSink::ResultSink() = default;
+
+void ResultSink::test_started(
+  char const *const /*group_name*/,
+  char const *const /*test_name*/,
+  unsigned long long const /*test_index*/) noexcept
+{
+}
+
+void ResultSink::assertion(
+  char const *const /*group_name*/,
+  char const *const /*test_name*/,
+  unsigned long long const /*index*/,
+  bool const /*passed*/,
+  char const *const /*message*/) noexcept
+{
+}
+
+void ResultSink::test_finished(
+  char const *const /*group_name*/,
+  char const *const /*test_name*/,
+  TestOutcome::Status const /*status*/) noexcept
+{
+}
+
 Group::~Group() = default;
 
 Group::Group(internal::Group_impl *const impl)
@@ -751,6 +1985,20 @@ Test3<void>::Test3(internal::Registrar<void> registrar)
 {
 }
 
+auto Test3<void>::isolated() && noexcept -> Test3
+{
+  this->registrar_.set_isolated();
+
+  return Test3{internal::move(this->registrar_)};
+}
+
+auto Test3<void>::thread_unsafe() && noexcept -> Test3
+{
+  this->registrar_.set_thread_unsafe();
+
+  return Test3{internal::move(this->registrar_)};
+}
+
 void Test3<void>::disable() && noexcept
 {
   this->registrar_.disable(true);
@@ -805,6 +2053,42 @@ auto TestRun::test(Group const &group, char const *name) const noexcept -> Test
   return this->impl_->make_test(test_id);
 }
 
+auto TestRun::register_group_fixture(
+  Group const &group,
+  internal::GroupFixtureFactory *const factory,
+  bool const is_snapshot) const -> unsigned long long
+{
+  return this->impl_->register_group_fixture(
+    this->impl_->get_group_id(group),
+    std::unique_ptr<internal::GroupFixtureFactory>{factory},
+    is_snapshot);
+}
+
+auto TestRun::get_group_fixture(unsigned long long const index) const
+  -> void *
+{
+  return this->impl_->get_group_fixture(index);
+}
+
+auto TestRun::register_shared_data(
+  internal::SharedDataFactory *const factory) const -> unsigned long long
+{
+  return this->impl_->register_shared_data(
+    std::unique_ptr<internal::SharedDataFactory>{factory});
+}
+
+auto TestRun::get_shared_data(unsigned long long const index) const
+  -> void const *
+{
+  return this->impl_->get_shared_data(index);
+}
+
+auto TestRun::get_shared_data_size(unsigned long long const index) const
+  -> unsigned long long
+{
+  return this->impl_->get_shared_data_size(index);
+}
+
 auto TestRun::create() -> TestRun
 {
   auto *impl = new internal::TestRun_impl{};
@@ -816,10 +2100,17 @@ void TestRun::register_test_assembly(
   internal::TestAssembly f,
   unsigned long long const test_id,
   unsigned long long const timeout_ms,
-  bool const disabled) const
+  bool const disabled,
+  bool const isolated,
+  bool const thread_unsafe) const
 {
-  this->impl_
-    ->register_test_assembly(std::move(f), test_id, timeout_ms, disabled);
+  this->impl_->register_test_assembly(
+    std::move(f),
+    test_id,
+    timeout_ms,
+    disabled,
+    isolated,
+    thread_unsafe);
 }
 
 void TestRun::report_incomplete_test(unsigned long long const test_id) const
@@ -848,33 +2139,18 @@ ContextInProcess::ContextInProcess(internal::ContextInProcess_impl *const impl)
 
 void ContextInProcess::assert(bool const condition) const noexcept
 {
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(
-      condition,
-      this->impl_->test_id(),
-      this->impl_->generate_assertion_index(),
-      std::nullopt);
+  this->impl_->register_assertion(condition, std::nullopt);
 }
 
 void ContextInProcess::assert(bool const condition, char const *const message)
   const noexcept
 {
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(
-      condition,
-      this->impl_->test_id(),
-      this->impl_->generate_assertion_index(),
-      message);
+  this->impl_->register_assertion(condition, message);
 }
 
 auto ContextInProcess::assume(bool const condition) const noexcept -> bool
 {
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(
-      condition,
-      this->impl_->test_id(),
-      this->impl_->generate_assertion_index(),
-      std::nullopt);
+  this->impl_->register_assertion(condition, std::nullopt);
 
   return condition;
 }
@@ -882,12 +2158,7 @@ auto ContextInProcess::assume(bool const condition) const noexcept -> bool
 auto ContextInProcess::assume(bool const condition, char const *const message)
   const noexcept -> bool
 {
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(
-      condition,
-      this->impl_->test_id(),
-      this->impl_->generate_assertion_index(),
-      message);
+  this->impl_->register_assertion(condition, message);
 
   return condition;
 }
@@ -906,16 +2177,13 @@ void ContextChildProcess::assert(bool const condition) const noexcept
 
   auto const index = this->impl_->generate_assertion_index();
 
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(condition, this->impl_->test_id(), index, std::nullopt);
-
   internal::get_impl(impl_->get_test_run())
     .transmit_assertion(
       condition,
       this->impl_->test_id(),
       index,
       std::nullopt,
-      *this->impl_->response_write_pipe());
+      *this->impl_->response_writer());
 }
 
 void ContextChildProcess::assert(
@@ -926,16 +2194,13 @@ void ContextChildProcess::assert(
 
   auto const index = this->impl_->generate_assertion_index();
 
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(condition, this->impl_->test_id(), index, message);
-
   internal::get_impl(impl_->get_test_run())
     .transmit_assertion(
       condition,
       this->impl_->test_id(),
       index,
       message,
-      *this->impl_->response_write_pipe());
+      *this->impl_->response_writer());
 }
 
 auto ContextChildProcess::assume(bool const condition) const noexcept -> bool
@@ -944,16 +2209,13 @@ auto ContextChildProcess::assume(bool const condition) const noexcept -> bool
 
   auto const index = this->impl_->generate_assertion_index();
 
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(condition, this->impl_->test_id(), index, std::nullopt);
-
   internal::get_impl(impl_->get_test_run())
     .transmit_assertion(
       condition,
       this->impl_->test_id(),
       index,
       std::nullopt,
-      *this->impl_->response_write_pipe());
+      *this->impl_->response_writer());
 
   return condition;
 }
@@ -966,16 +2228,13 @@ auto ContextChildProcess::assume(
 
   auto const index = this->impl_->generate_assertion_index();
 
-  internal::get_impl(impl_->get_test_run())
-    .register_assertion(condition, this->impl_->test_id(), index, message);
-
   internal::get_impl(impl_->get_test_run())
     .transmit_assertion(
       condition,
       this->impl_->test_id(),
       index,
       message,
-      *this->impl_->response_write_pipe());
+      *this->impl_->response_writer());
 
   return condition;
 }
@@ -1008,6 +2267,17 @@ auto TestRunResult::test_outcome(unsigned long long const index) const noexcept
   return this->impl_->get_test_outcome(index);
 }
 
+auto TestRunResult::failing_test_count() const noexcept -> unsigned long long
+{
+  return this->impl_->failing_test_count();
+}
+
+auto TestRunResult::failing_test_outcome(
+  unsigned long long const index) const noexcept -> TestOutcome const &
+{
+  return this->impl_->get_failing_test_outcome(index);
+}
+
 auto TestRunResult::error_count() const noexcept -> unsigned long long
 {
   return this->impl_->errors().size();
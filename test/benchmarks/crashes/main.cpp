@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "waypoint/waypoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+constexpr unsigned test_count = 2'000;
+constexpr unsigned repetitions = 3;
+constexpr auto crash_interval_env = "BENCHMARK_CRASH_INTERVAL";
+
+auto crash_interval() -> unsigned
+{
+  return static_cast<unsigned>(std::stoul(std::getenv(crash_interval_env)));
+}
+
+auto measure(unsigned const interval) -> std::chrono::microseconds
+{
+  ::setenv(crash_interval_env, std::to_string(interval).c_str(), 1);
+
+  auto const t = waypoint::TestRun::create();
+
+  auto const start = std::chrono::steady_clock::now();
+  [[maybe_unused]]
+  auto const results = run_all_tests(t);
+  auto const end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Crash benchmark");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g, std::format("Test {}", i).c_str())
+      .run(
+        [i](waypoint::Context const &ctx)
+        {
+          ctx.assert(true);
+
+          if(i % crash_interval() == 0)
+          {
+            std::abort();
+          }
+        });
+  }
+}
+
+auto main() -> int
+{
+  // Children inherit the crash interval and only serve the parent
+  if(std::getenv(crash_interval_env) != nullptr)
+  {
+    [[maybe_unused]]
+    auto const results = run_all_tests(waypoint::TestRun::create());
+
+    return 0;
+  }
+
+  // The suite size stays fixed, so the cost of one crash must
+  // not grow with the number of crashes
+  for(auto const interval : {8U, 4U, 2U, 1U})
+  {
+    auto best = std::chrono::microseconds::max();
+    for(unsigned i = 0; i < repetitions; ++i)
+    {
+      best = std::min(best, measure(interval));
+    }
+
+    auto const crash_count = (test_count + interval - 1) / interval;
+    std::cout << std::format(
+                   "{:>6} crashes{:>12} us{:>12.1f} us/crash",
+                   crash_count,
+                   best.count(),
+                   static_cast<double>(best.count()) / crash_count)
+              << std::endl;
+  }
+
+  return 0;
+}
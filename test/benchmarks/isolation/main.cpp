@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "waypoint/waypoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <initializer_list>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+
+constexpr unsigned test_count = 2'000;
+constexpr unsigned assertions_per_test = 10;
+constexpr unsigned repetitions = 5;
+
+void small_body(waypoint::Context const &ctx)
+{
+  for(unsigned i = 0; i < assertions_per_test; ++i)
+  {
+    ctx.assert(true);
+  }
+}
+
+auto measure(waypoint::RunConfig::Isolation const isolation)
+  -> std::chrono::microseconds
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.isolation(isolation);
+
+  auto const start = std::chrono::steady_clock::now();
+  [[maybe_unused]]
+  auto const results = run_all_tests(t, config);
+  auto const end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Isolation benchmark");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g, std::format("Test {}", i).c_str()).run(small_body);
+  }
+}
+
+auto main() -> int
+{
+  auto const isolations = {
+    std::pair{waypoint::RunConfig::Isolation::SharedChild, "shared_child"},
+    std::pair{waypoint::RunConfig::Isolation::PerTest, "per_test"}};
+
+  for(auto const &[isolation, name] : isolations)
+  {
+    auto best = std::chrono::microseconds::max();
+    for(unsigned i = 0; i < repetitions; ++i)
+    {
+      best = std::min(best, measure(isolation));
+    }
+
+    std::cout << std::format(
+                   "{:<16}{:>12} us{:>12.1f} us/test",
+                   name,
+                   best.count(),
+                   static_cast<double>(best.count()) / test_count)
+              << std::endl;
+  }
+
+  return 0;
+}
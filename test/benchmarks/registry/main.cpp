@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "waypoint/waypoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr unsigned repetitions = 3;
+
+void empty_body(waypoint::Context const & /*ctx*/)
+{
+}
+
+struct Timings
+{
+  std::chrono::microseconds registration;
+  std::chrono::microseconds run;
+};
+
+auto measure(std::vector<std::string> const &names) -> Timings
+{
+  auto const t = waypoint::TestRun::create();
+
+  auto const start = std::chrono::steady_clock::now();
+  auto const g = t.group("Registry benchmark");
+  for(auto const &name : names)
+  {
+    t.test(g, name.c_str()).run(empty_body);
+  }
+  auto const registered = std::chrono::steady_clock::now();
+  [[maybe_unused]]
+  auto const results = run_all_tests_in_process(t);
+  auto const end = std::chrono::steady_clock::now();
+
+  return {
+    std::chrono::duration_cast<std::chrono::microseconds>(registered - start),
+    std::chrono::duration_cast<std::chrono::microseconds>(end - registered)};
+}
+
+} // namespace
+
+// Registration and lookups by id must stay linear in the number of
+// tests, up to a million of them
+auto main() -> int
+{
+  for(auto const test_count : {1'000U, 10'000U, 100'000U, 1'000'000U})
+  {
+    std::vector<std::string> names;
+    names.reserve(test_count);
+    for(unsigned i = 0; i < test_count; ++i)
+    {
+      names.push_back(std::format("Test {}", i));
+    }
+
+    auto best = Timings{
+      std::chrono::microseconds::max(),
+      std::chrono::microseconds::max()};
+    for(unsigned i = 0; i < repetitions; ++i)
+    {
+      auto const timings = measure(names);
+      best.registration = std::min(best.registration, timings.registration);
+      best.run = std::min(best.run, timings.run);
+    }
+
+    std::cout << std::format(
+                   "{:>8} tests{:>10.3f} us/registration{:>10.3f} us/run",
+                   test_count,
+                   static_cast<double>(best.registration.count()) / test_count,
+                   static_cast<double>(best.run.count()) / test_count)
+              << std::endl;
+  }
+
+  return 0;
+}
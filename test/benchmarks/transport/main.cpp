@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "waypoint/waypoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+constexpr unsigned heavy_test_count = 64;
+constexpr unsigned assertions_per_heavy_test = 20'000;
+constexpr unsigned light_test_count = 4'000;
+constexpr unsigned repetitions = 5;
+
+void assertion_heavy_body(waypoint::Context const &ctx)
+{
+  for(unsigned i = 0; i < assertions_per_heavy_test; ++i)
+  {
+    ctx.assert(i % 7 != 0, "Benchmark assertion message");
+  }
+}
+
+void light_body(waypoint::Context const &ctx)
+{
+  ctx.assert(true);
+}
+
+auto measure(waypoint::RunConfig::Transport const transport)
+  -> std::chrono::microseconds
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.transport(transport);
+
+  auto const start = std::chrono::steady_clock::now();
+  [[maybe_unused]]
+  auto const results = run_all_tests(t, config);
+  auto const end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Transport benchmark");
+
+  for(unsigned i = 0; i < heavy_test_count; ++i)
+  {
+    t.test(g, std::format("Heavy test {}", i).c_str())
+      .run(assertion_heavy_body)
+      .timeout_ms(60'000);
+  }
+
+  for(unsigned i = 0; i < light_test_count; ++i)
+  {
+    t.test(g, std::format("Light test {}", i).c_str()).run(light_body);
+  }
+}
+
+auto main() -> int
+{
+  auto const transports = {
+    std::pair{waypoint::RunConfig::Transport::Pipe, "pipe"},
+    std::pair{waypoint::RunConfig::Transport::SharedMemory, "shared_memory"}};
+
+  for(auto const &[transport, name] : transports)
+  {
+    auto best = std::chrono::microseconds::max();
+    for(unsigned i = 0; i < repetitions; ++i)
+    {
+      best = std::min(best, measure(transport));
+    }
+
+    auto const assertion_count =
+      static_cast<double>(heavy_test_count) * assertions_per_heavy_test +
+      light_test_count;
+    auto const seconds = std::chrono::duration<double>(best).count();
+    std::cout << std::format(
+                   "{:<16}{:>12} us{:>16.0f} assertions/s",
+                   name,
+                   best.count(),
+                   assertion_count / seconds)
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -199,9 +199,6 @@ void register_test_moveable_unique_ptr(
 
 WAYPOINT_AUTORUN(waypoint::TestRun const &t)
 {
-  register_test_unique_ptr<waypoint::internal::AssertionOutcome_impl>(
-    t,
-    "AssertionOutcome_impl");
   register_test_unique_ptr<waypoint::internal::AutorunFunctionPtrVector_impl>(
     t,
     "AutorunFunctionPtrVector_impl");
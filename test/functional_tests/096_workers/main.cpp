@@ -0,0 +1,158 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+
+void assert_pid(waypoint::Context const &ctx)
+{
+  ctx.assert(true, std::to_string(::getpid()).c_str());
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 1")
+    .setup(assert_pid)
+    .run(waypoint::test::body_call_std_abort);
+
+  t.test(g1, "Test 2")
+    .setup(assert_pid)
+    .run(waypoint::test::body_call_std_exit_123)
+    .teardown(waypoint::test::trivial_test_teardown);
+
+  t.test(g1, "Test 3")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_test_body);
+
+  t.test(g1, "Test 4")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_failing_body);
+
+  t.test(g1, "Test 5")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_failing_body)
+    .disable();
+
+  t.test(g1, "Test 6")
+    .setup(assert_pid)
+    .run(waypoint::test::body_long_sleep)
+    .timeout_ms(10);
+
+  t.test(g1, "Test 7")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_test_body);
+
+  t.test(g1, "Test 8")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_test_body);
+
+  t.test(g1, "Test 9")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_test_body);
+
+  t.test(g1, "Test 10")
+    .setup(assert_pid)
+    .run(waypoint::test::trivial_test_body);
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(4);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  auto const error_count = results.error_count();
+  REQUIRE_IN_MAIN(
+    error_count == 0,
+    std::format("Expected error_count to be 0, but it is {}", error_count));
+
+  auto const test_count = results.test_count();
+  REQUIRE_IN_MAIN(
+    test_count == 10,
+    std::format("Expected test_count to be 10, but it is {}", test_count));
+
+  std::vector const expected_statuses = {
+    waypoint::TestOutcome::Status::Terminated,
+    waypoint::TestOutcome::Status::Terminated,
+    waypoint::TestOutcome::Status::Success,
+    waypoint::TestOutcome::Status::Failure,
+    waypoint::TestOutcome::Status::NotRun,
+    waypoint::TestOutcome::Status::Timeout,
+    waypoint::TestOutcome::Status::Success,
+    waypoint::TestOutcome::Status::Success,
+    waypoint::TestOutcome::Status::Success,
+    waypoint::TestOutcome::Status::Success,
+  };
+  std::vector const expected_assertion_counts =
+    {2U, 2U, 3U, 3U, 0U, 2U, 3U, 3U, 3U, 3U};
+
+  std::set<std::string> worker_pids;
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+
+    auto const expected_status = expected_statuses[i];
+    auto const actual_status = outcome.status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected actual_status to be {}, but it is {}",
+        std::make_format_args(expected_status, actual_status)));
+
+    auto const expected_assertion_count = expected_assertion_counts[i];
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == expected_assertion_count,
+      std::format(
+        "Expected outcome.assertion_count() to be {}, but it is {}",
+        expected_assertion_count,
+        outcome.assertion_count()));
+
+    if(outcome.status() == waypoint::TestOutcome::Status::Terminated)
+    {
+      REQUIRE_IN_MAIN(
+        outcome.exit_code() != nullptr,
+        "Expected outcome.exit_code() != nullptr");
+      REQUIRE_IN_MAIN(*outcome.exit_code() > 0, "*outcome.exit_code() > 0");
+    }
+    else
+    {
+      REQUIRE_IN_MAIN(
+        outcome.exit_code() == nullptr,
+        "Expected outcome.exit_code() == nullptr");
+    }
+
+    if(outcome.assertion_count() > 0)
+    {
+      worker_pids.insert(outcome.assertion_outcome(0).message());
+    }
+  }
+
+  REQUIRE_IN_MAIN(
+    worker_pids.size() >= 4,
+    std::format(
+      "Expected at least 4 distinct worker processes, but there were {}",
+      worker_pids.size()));
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <set>
+#include <string>
+
+// NOLINTNEXTLINE(modernize-deprecated-headers)
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace
+{
+
+void assert_pid(waypoint::Context const &ctx)
+{
+  ctx.assert(true, std::to_string(::getpid()).c_str());
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 1").run(assert_pid);
+  t.test(g1, "Test 2").run(assert_pid);
+  t.test(g1, "Test 3").run(assert_pid);
+  t.test(g1, "Test 4").run(assert_pid);
+  t.test(g1, "Test 5").run(assert_pid);
+  t.test(g1, "Test 6").run(assert_pid);
+}
+
+auto main() -> int
+{
+  ::setenv("WAYPOINT_WORKERS", "3", 1);
+
+  auto const t = waypoint::TestRun::create();
+
+  auto const results = run_all_tests(t);
+
+  REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+
+  auto const test_count = results.test_count();
+  REQUIRE_IN_MAIN(
+    test_count == 6,
+    std::format("Expected test_count to be 6, but it is {}", test_count));
+
+  std::set<std::string> worker_pids;
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == 1,
+      std::format(
+        "Expected outcome.assertion_count() to be 1, but it is {}",
+        outcome.assertion_count()));
+
+    worker_pids.insert(outcome.assertion_outcome(0).message());
+  }
+
+  REQUIRE_IN_MAIN(
+    worker_pids.size() == 3,
+    std::format(
+      "Expected 3 distinct worker processes, but there were {}",
+      worker_pids.size()));
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <functional>
+#include <string>
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < 24; ++i)
+  {
+    auto const name = std::format("Test {}", i);
+
+    if(i % 8 == 3)
+    {
+      t.test(g1, name.c_str()).run(waypoint::test::body_call_std_abort);
+    }
+    else if(i % 8 == 6)
+    {
+      t.test(g1, name.c_str())
+        .run(waypoint::test::body_long_sleep)
+        .timeout_ms(10);
+    }
+    else
+    {
+      t.test(g1, name.c_str()).run(waypoint::test::trivial_test_body);
+    }
+  }
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(2).pipeline_depth(4);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  auto const test_count = results.test_count();
+  REQUIRE_IN_MAIN(
+    test_count == 24,
+    std::format("Expected test_count to be 24, but it is {}", test_count));
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+
+    auto const expected_status = std::invoke(
+      [i]()
+      {
+        if(i % 8 == 3)
+        {
+          return waypoint::TestOutcome::Status::Terminated;
+        }
+
+        if(i % 8 == 6)
+        {
+          return waypoint::TestOutcome::Status::Timeout;
+        }
+
+        return waypoint::TestOutcome::Status::Success;
+      });
+    auto const actual_status = outcome.status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected status of test {} to be {}, but it is {}",
+        std::make_format_args(i, expected_status, actual_status)));
+
+    if(actual_status == waypoint::TestOutcome::Status::Success)
+    {
+      REQUIRE_IN_MAIN(
+        outcome.assertion_count() == 2,
+        std::format(
+          "Expected test {} to have 2 assertions, but it has {}",
+          i,
+          outcome.assertion_count()));
+    }
+
+    if(actual_status == waypoint::TestOutcome::Status::Terminated)
+    {
+      REQUIRE_IN_MAIN(
+        outcome.exit_code() != nullptr,
+        "Expected outcome.exit_code() != nullptr");
+    }
+    else
+    {
+      REQUIRE_IN_MAIN(
+        outcome.exit_code() == nullptr,
+        "Expected outcome.exit_code() == nullptr");
+    }
+  }
+
+  return 0;
+}
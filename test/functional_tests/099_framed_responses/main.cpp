@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <string>
+
+namespace
+{
+
+constexpr unsigned assertion_count = 1'000;
+constexpr unsigned long long long_message_size = 200'000;
+
+auto message_for(unsigned const i) -> std::string
+{
+  if(i == assertion_count / 2)
+  {
+    return std::string(long_message_size, 'x');
+  }
+
+  return std::string(i % 300, static_cast<char>('a' + (i % 26)));
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 1")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        for(unsigned i = 0; i < assertion_count; ++i)
+        {
+          if(i % 7 == 0)
+          {
+            ctx.assert(i % 2 == 0);
+          }
+          else
+          {
+            ctx.assert(i % 2 == 0, message_for(i).c_str());
+          }
+        }
+      });
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  auto const results = run_all_tests(t);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  auto const &outcome = results.test_outcome(0);
+  REQUIRE_IN_MAIN(
+    outcome.assertion_count() == assertion_count,
+    std::format(
+      "Expected outcome.assertion_count() to be {}, but it is {}",
+      assertion_count,
+      outcome.assertion_count()));
+
+  for(unsigned i = 0; i < assertion_count; ++i)
+  {
+    auto const &assertion = outcome.assertion_outcome(i);
+
+    REQUIRE_IN_MAIN(
+      assertion.index() == i,
+      std::format(
+        "Expected assertion.index() to be {}, but it is {}",
+        i,
+        assertion.index()));
+    REQUIRE_IN_MAIN(
+      assertion.passed() == (i % 2 == 0),
+      std::format("Unexpected assertion.passed() for assertion {}", i));
+
+    if(i % 7 == 0)
+    {
+      REQUIRE_IN_MAIN(
+        assertion.message() == nullptr,
+        std::format("Expected assertion {} to have no message", i));
+    }
+    else
+    {
+      REQUIRE_IN_MAIN(
+        assertion.message() != nullptr && message_for(i) == assertion.message(),
+        std::format("Unexpected message for assertion {}", i));
+    }
+  }
+
+  return 0;
+}
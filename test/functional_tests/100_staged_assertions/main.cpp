@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+constexpr unsigned many_assertions = 20'000;
+constexpr unsigned long long huge_message_size = 2'000'000;
+
+auto message_for(unsigned const i) -> std::string
+{
+  return std::format("{:0>100}", i);
+}
+
+void many_assertions_body(waypoint::Context const &ctx)
+{
+  for(unsigned i = 0; i < many_assertions; ++i)
+  {
+    ctx.assert(i % 3 != 0, message_for(i).c_str());
+  }
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 1")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        many_assertions_body(ctx);
+        std::abort();
+      })
+    .timeout_ms(5'000);
+
+  t.test(g1, "Test 2")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        many_assertions_body(ctx);
+        std::this_thread::sleep_for(std::chrono::seconds{10});
+      })
+    .timeout_ms(3'000);
+
+  t.test(g1, "Test 3")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(false, std::string(huge_message_size, 'x').c_str());
+        ctx.assert(true);
+        std::exit(3);
+      })
+    .timeout_ms(5'000);
+
+  t.test(g1, "Test 4").run(many_assertions_body).timeout_ms(5'000);
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.flush_interval_ms(1);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  auto const expected_statuses = {
+    waypoint::TestOutcome::Status::Terminated,
+    waypoint::TestOutcome::Status::Timeout,
+    waypoint::TestOutcome::Status::Terminated,
+    waypoint::TestOutcome::Status::Failure};
+
+  unsigned test_index = 0;
+  for(auto const expected_status : expected_statuses)
+  {
+    auto const actual_status = results.test_outcome(test_index).status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected status of test {} to be {}, but it is {}",
+        std::make_format_args(test_index, expected_status, actual_status)));
+
+    ++test_index;
+  }
+
+  for(unsigned long long const i : {0, 1, 3})
+  {
+    auto const &outcome = results.test_outcome(i);
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == many_assertions,
+      std::format(
+        "Expected test {} to have {} assertions, but it has {}",
+        i,
+        many_assertions,
+        outcome.assertion_count()));
+
+    for(unsigned j = 0; j < many_assertions; ++j)
+    {
+      auto const &assertion = outcome.assertion_outcome(j);
+      REQUIRE_IN_MAIN(
+        assertion.index() == j && assertion.passed() == (j % 3 != 0) &&
+          message_for(j) == assertion.message(),
+        std::format("Unexpected assertion {} in test {}", j, i));
+    }
+  }
+
+  auto const &outcome = results.test_outcome(2);
+  REQUIRE_IN_MAIN(
+    outcome.assertion_count() == 2,
+    std::format(
+      "Expected test 2 to have 2 assertions, but it has {}",
+      outcome.assertion_count()));
+  REQUIRE_IN_MAIN(
+    std::string(outcome.assertion_outcome(0).message()).size() ==
+      huge_message_size,
+    "Unexpected size of the huge message");
+  REQUIRE_IN_MAIN(
+    outcome.exit_code() != nullptr && *outcome.exit_code() == 3,
+    "Expected test 2 to exit with code 3");
+
+  return 0;
+}
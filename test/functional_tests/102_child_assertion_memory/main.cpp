@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+constexpr unsigned many_assertions = 200'000;
+constexpr unsigned long long max_growth_kib = 2'048;
+
+auto anonymous_rss_kib() -> unsigned long long
+{
+  std::ifstream status{"/proc/self/status"};
+
+  std::string key;
+  while(status >> key)
+  {
+    if(key == "RssAnon:")
+    {
+      unsigned long long value = 0;
+      status >> value;
+
+      return value;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 1")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        // Warm up the transport before taking the baseline
+        ctx.assert(true, "Warm-up assertion");
+
+        auto const rss_before = anonymous_rss_kib();
+        for(unsigned i = 0; i < many_assertions; ++i)
+        {
+          ctx.assert(true, "Assertion with a message");
+        }
+        auto const rss_after = anonymous_rss_kib();
+
+        ctx.assert(
+          rss_before > 0 && rss_after <= rss_before + max_growth_kib,
+          "Child memory grew with the number of assertions");
+      })
+    .timeout_ms(60'000);
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  auto const results = run_all_tests(t);
+
+  auto const &outcome = results.test_outcome(0);
+  REQUIRE_IN_MAIN(
+    outcome.status() == waypoint::TestOutcome::Status::Success,
+    "Expected child memory to stay flat");
+  REQUIRE_IN_MAIN(
+    outcome.assertion_count() == many_assertions + 2,
+    std::format(
+      "Expected {} assertions, but got {}",
+      many_assertions + 2,
+      outcome.assertion_count()));
+
+  return 0;
+}
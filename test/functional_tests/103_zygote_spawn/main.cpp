@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+
+#include <unistd.h>
+
+namespace
+{
+
+// Workers forked from the zygote keep the runner's value,
+// while an exec'd child would compute its own
+::pid_t const runner_pid = ::getpid();
+
+unsigned autorun_count = 0;
+
+void forked_from_zygote_body(waypoint::Context const &ctx)
+{
+  ctx.assert(::getpid() != runner_pid, "Worker was not forked");
+  ctx.assert(::getppid() != runner_pid, "Worker was not forked by zygote");
+  ctx.assert(autorun_count == 1, "Autorun blocks were run again");
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  ++autorun_count;
+
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < 12; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [i](waypoint::Context const &ctx)
+        {
+          forked_from_zygote_body(ctx);
+
+          if(i % 4 == 1)
+          {
+            waypoint::test::body_call_std_abort(ctx);
+          }
+          if(i % 4 == 2)
+          {
+            waypoint::test::body_call_std_exit_123(ctx);
+          }
+        });
+  }
+
+  t.test(g1, "Test 12").run(waypoint::test::body_long_sleep);
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.spawn(waypoint::RunConfig::Spawn::Zygote).workers(2).pipeline_depth(
+    2);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+  REQUIRE_IN_MAIN(autorun_count == 1, "Expected autorun blocks to run once");
+
+  for(unsigned long long i = 0; i < 12; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    auto const crashes = i % 4 == 1 || i % 4 == 2;
+    auto const expected_status = crashes
+      ? waypoint::TestOutcome::Status::Terminated
+      : waypoint::TestOutcome::Status::Success;
+    auto const actual_status = outcome.status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected status of test {} to be {}, but it is {}",
+        std::make_format_args(i, expected_status, actual_status)));
+    auto const expected_assertion_count = crashes ? 4ULL : 3ULL;
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == expected_assertion_count,
+      std::format(
+        "Expected test {} to have {} assertions, but it has {}",
+        i,
+        expected_assertion_count,
+        outcome.assertion_count()));
+  }
+
+  auto const &outcome = results.test_outcome(2);
+  REQUIRE_IN_MAIN(
+    outcome.exit_code() != nullptr && *outcome.exit_code() == 123,
+    "Expected test 2 to exit with code 123");
+
+  auto const status = results.test_outcome(12).status();
+  REQUIRE_IN_MAIN(
+    status == waypoint::TestOutcome::Status::Timeout,
+    std::vformat(
+      "Expected test 12 to time out, but its status is {}",
+      std::make_format_args(status)));
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <future>
+#include <thread>
+
+#include <unistd.h>
+
+namespace
+{
+
+::pid_t const runner_pid = ::getpid();
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < 4; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [](waypoint::Context const &ctx)
+        {
+          ctx.assert(::getpid() == runner_pid, "Worker was not exec'd");
+        });
+  }
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  // Another live thread makes forking unsafe,
+  // so workers have to be exec'd as usual
+  std::promise<void> release;
+  std::thread other_thread{[future = release.get_future()]() mutable
+                           {
+                             future.wait();
+                           }};
+
+  waypoint::RunConfig config;
+  config.spawn(waypoint::RunConfig::Spawn::Zygote);
+
+  auto const results = run_all_tests(t, config);
+
+  release.set_value();
+  other_thread.join();
+
+  REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+  REQUIRE_IN_MAIN(
+    results.test_count() == 4,
+    std::format("Expected 4 tests, got {}", results.test_count()));
+
+  return 0;
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <cstdlib>
+#include <format>
+#include <set>
+#include <string>
+
+#include <unistd.h>
+
+namespace
+{
+
+int touched = 0;
+
+// Every test reports its process and parent process through the
+// messages of its first two assertions
+void report_processes(waypoint::Context const &ctx)
+{
+  ctx.assert(true, std::to_string(::getpid()).c_str());
+  ctx.assert(true, std::to_string(::getppid()).c_str());
+}
+
+void shared_body(waypoint::Context const &ctx)
+{
+  report_processes(ctx);
+  ctx.assert(touched == 0, "State leaked out of an isolated test");
+}
+
+void isolated_body(waypoint::Context const &ctx)
+{
+  report_processes(ctx);
+  ctx.assert(touched == 0, "State leaked between isolated tests");
+  touched = 1;
+}
+
+auto process_id(waypoint::TestOutcome const &outcome, unsigned long long index)
+  -> std::string
+{
+  return outcome.assertion_outcome(index).message();
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 0").run(shared_body);
+  t.test(g1, "Test 1").run(isolated_body).isolated();
+  t.test(g1, "Test 2")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        isolated_body(ctx);
+        std::abort();
+      })
+    .isolated();
+  t.test(g1, "Test 3").run(shared_body);
+  t.test(g1, "Test 4")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        isolated_body(ctx);
+        waypoint::test::body_long_sleep(ctx);
+      })
+    .timeout_ms(200)
+    .isolated();
+  t.test(g1, "Test 5").run(shared_body);
+  t.test(g1, "Test 6")
+    .run(isolated_body)
+    .teardown(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(touched == 1);
+      })
+    .isolated();
+  t.test(g1, "Test 7")
+    .setup(
+      [](waypoint::Context const &ctx)
+      {
+        report_processes(ctx);
+
+        return 7;
+      })
+    .run(
+      [](waypoint::Context const &, int const &fixture)
+      {
+        std::exit(fixture);
+      })
+    .isolated();
+  t.test(g1, "Test 8").run(shared_body);
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  auto const results = run_all_tests(t);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  using Status = waypoint::TestOutcome::Status;
+  auto const expected_statuses = {
+    Status::Success,
+    Status::Success,
+    Status::Terminated,
+    Status::Success,
+    Status::Timeout,
+    Status::Success,
+    Status::Success,
+    Status::Terminated,
+    Status::Success};
+
+  unsigned long long test_index = 0;
+  for(auto const expected_status : expected_statuses)
+  {
+    auto const actual_status = results.test_outcome(test_index).status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected status of test {} to be {}, but it is {}",
+        std::make_format_args(test_index, expected_status, actual_status)));
+    REQUIRE_IN_MAIN(
+      test_index == 7 ||
+        results.test_outcome(test_index).assertion_outcome(2).passed(),
+      std::format("Unexpected state in test {}", test_index));
+
+    ++test_index;
+  }
+
+  auto const &outcome = results.test_outcome(7);
+  REQUIRE_IN_MAIN(
+    outcome.exit_code() != nullptr && *outcome.exit_code() == 7,
+    "Expected test 7 to exit with code 7");
+
+  // Crashes and timeouts in isolated tests leave the shared child alive
+  std::set<std::string> shared_child;
+  for(unsigned long long const i : {0, 3, 5, 8})
+  {
+    shared_child.insert(process_id(results.test_outcome(i), 0));
+  }
+  REQUIRE_IN_MAIN(
+    shared_child.size() == 1,
+    "Expected all shared tests to run in one child");
+
+  std::set<std::string> isolated_children;
+  for(unsigned long long const i : {1, 2, 4, 6, 7})
+  {
+    auto const &isolated_outcome = results.test_outcome(i);
+    isolated_children.insert(process_id(isolated_outcome, 0));
+    REQUIRE_IN_MAIN(
+      shared_child.contains(process_id(isolated_outcome, 1)),
+      std::format("Expected test {} to be forked from the shared child", i));
+  }
+  REQUIRE_IN_MAIN(
+    isolated_children.size() == 5 &&
+      !isolated_children.contains(*shared_child.begin()),
+    "Expected every isolated test to run in its own process");
+
+  return 0;
+}
@@ -0,0 +1,201 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned test_count = 40;
+
+// Every process appends what it does here, so the parent can tell which
+// child replaced a crashed one and when that child was spawned
+char const *const log_path_env_name = "WAYPOINT_TEST_STANDBY_LOG_PATH";
+
+// Gives a standby spawned while a test runs the time to log its start
+// before the test crashes
+constexpr std::chrono::milliseconds crash_delay{50};
+
+void log_event(char const *const event)
+{
+  std::ofstream log{std::getenv(log_path_env_name), std::ios::app};
+  log << std::format("{} {}\n", event, ::getpid()) << std::flush;
+}
+
+struct Event
+{
+  std::string name;
+  long long pid;
+};
+
+auto read_log(std::filesystem::path const &path) -> std::vector<Event>
+{
+  std::vector<Event> events;
+  std::ifstream log{path};
+  Event event;
+  while(log >> event.name >> event.pid)
+  {
+    events.push_back(event);
+  }
+
+  return events;
+}
+
+// Counts crashes whose replacement child was spawned before the crash,
+// which only a standby child can be
+auto count_standby_replacements(std::vector<Event> const &events)
+  -> unsigned
+{
+  std::unordered_map<long long, std::size_t> spawned_at;
+  unsigned count = 0;
+  for(std::size_t i = 0; i < events.size(); ++i)
+  {
+    if(events[i].name == "spawned")
+    {
+      spawned_at.emplace(events[i].pid, i);
+    }
+    if(events[i].name != "crashing")
+    {
+      continue;
+    }
+
+    for(std::size_t j = i + 1; j < events.size(); ++j)
+    {
+      if(events[j].name == "ran" && events[j].pid != events[i].pid)
+      {
+        auto const spawned = spawned_at.find(events[j].pid);
+        if(spawned != spawned_at.end() && spawned->second < i)
+        {
+          ++count;
+        }
+        break;
+      }
+    }
+  }
+
+  return count;
+}
+
+auto crashes(unsigned long long const i) -> bool
+{
+  return i % 3 != 0;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [i](waypoint::Context const &ctx)
+        {
+          log_event("ran");
+          waypoint::test::trivial_test_body(ctx);
+
+          if(crashes(i))
+          {
+            std::this_thread::sleep_for(crash_delay);
+            log_event("crashing");
+            waypoint::test::body_call_std_abort(ctx);
+          }
+        });
+  }
+
+  t.test(g1, std::format("Test {}", test_count).c_str())
+    .run(waypoint::test::body_long_sleep);
+  t.test(g1, std::format("Test {}", test_count + 1).c_str())
+    .run(waypoint::test::trivial_test_body);
+}
+
+auto main() -> int
+{
+  // Workers run main too, and keep the path of the process which
+  // spawned them
+  if(std::getenv(log_path_env_name) == nullptr)
+  {
+    ::setenv(
+      log_path_env_name,
+      (std::filesystem::temp_directory_path() /
+       std::format("waypoint_standby_child_{}", ::getpid()))
+        .c_str(),
+      1);
+    std::filesystem::remove(std::getenv(log_path_env_name));
+  }
+  std::filesystem::path const log_path{std::getenv(log_path_env_name)};
+  log_event("spawned");
+
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  // Exec'd children run main, so they log when they are spawned
+  config.workers(1).pipeline_depth(2).spawn(
+    waypoint::RunConfig::Spawn::Exec);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  for(unsigned long long i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    auto const expected_status = crashes(i)
+      ? waypoint::TestOutcome::Status::Terminated
+      : waypoint::TestOutcome::Status::Success;
+    auto const actual_status = outcome.status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected status of test {} to be {}, but it is {}",
+        std::make_format_args(i, expected_status, actual_status)));
+    auto const expected_assertion_count = crashes(i) ? 3ULL : 2ULL;
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == expected_assertion_count,
+      std::format(
+        "Expected test {} to have {} assertions, but it has {}",
+        i,
+        expected_assertion_count,
+        outcome.assertion_count()));
+  }
+
+  auto status = results.test_outcome(test_count).status();
+  REQUIRE_IN_MAIN(
+    status == waypoint::TestOutcome::Status::Timeout,
+    std::vformat(
+      "Expected test {} to time out, but its status is {}",
+      std::make_format_args(test_count, status)));
+
+  status = results.test_outcome(test_count + 1).status();
+  REQUIRE_IN_MAIN(
+    status == waypoint::TestOutcome::Status::Success,
+    std::vformat(
+      "Expected test {} to succeed, but its status is {}",
+      std::make_format_args(test_count + 1, status)));
+
+  auto const standby_replacements =
+    count_standby_replacements(read_log(log_path));
+  std::filesystem::remove(log_path);
+  REQUIRE_IN_MAIN(
+    standby_replacements > 0,
+    "Expected a crashed child to be replaced by a standby spawned before "
+    "the crash");
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+auto thread_count() -> unsigned long long
+{
+  std::ifstream status{"/proc/self/status"};
+
+  std::string key;
+  while(status >> key)
+  {
+    if(key == "Threads:")
+    {
+      unsigned long long count = 0;
+      status >> count;
+
+      return count;
+    }
+  }
+
+  return 0;
+}
+
+void no_watchdog_body(waypoint::Context const &ctx)
+{
+  ctx.assert(thread_count() == 1, "Test body runs beside other threads");
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 0").run(no_watchdog_body).timeout_ms(1'000);
+  t.test(g1, "Test 1")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        no_watchdog_body(ctx);
+        ctx.assert(true);
+        waypoint::test::body_long_sleep(ctx);
+      })
+    .timeout_ms(50);
+  t.test(g1, "Test 2")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        no_watchdog_body(ctx);
+
+        // Never reaches a point where it could be interrupted
+        for(bool volatile spin = true; spin;)
+        {
+        }
+      })
+    .timeout_ms(50);
+  t.test(g1, "Test 3").run(no_watchdog_body);
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.pipeline_depth(4);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+
+  using Status = waypoint::TestOutcome::Status;
+  std::vector const expected_statuses = {
+    Status::Success,
+    Status::Timeout,
+    Status::Timeout,
+    Status::Success};
+  std::vector const expected_assertion_counts = {1ULL, 3ULL, 1ULL, 1ULL};
+
+  for(unsigned long long i = 0; i < expected_statuses.size(); ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+
+    auto const expected_status = expected_statuses[i];
+    auto const actual_status = outcome.status();
+    REQUIRE_IN_MAIN(
+      actual_status == expected_status,
+      std::vformat(
+        "Expected status of test {} to be {}, but it is {}",
+        std::make_format_args(i, expected_status, actual_status)));
+
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == expected_assertion_counts[i],
+      std::format(
+        "Expected test {} to have {} assertions, but it has {}",
+        i,
+        expected_assertion_counts[i],
+        outcome.assertion_count()));
+
+    REQUIRE_IN_MAIN(
+      outcome.exit_code() == nullptr,
+      std::format("Expected test {} to have no exit code", i));
+  }
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <format>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned test_count = 16;
+constexpr unsigned slow_test = 3;
+
+auto now_ns() -> long long
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// The first assertion reports the process, the second when the test
+// started and the last when it ended
+void timed_body(
+  waypoint::Context const &ctx,
+  std::chrono::milliseconds const duration)
+{
+  ctx.assert(true, std::to_string(::getpid()).c_str());
+  ctx.assert(true, std::to_string(now_ns()).c_str());
+  std::this_thread::sleep_for(duration);
+  ctx.assert(true, std::to_string(now_ns()).c_str());
+}
+
+auto message_number(
+  waypoint::TestOutcome const &outcome,
+  unsigned long long const index) -> long long
+{
+  return std::stoll(outcome.assertion_outcome(index).message());
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    auto const duration =
+      std::chrono::milliseconds{i == slow_test ? 1'500 : 10};
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [duration](waypoint::Context const &ctx)
+        {
+          timed_body(ctx, duration);
+        })
+      .timeout_ms(5'000);
+  }
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(2).pipeline_depth(8);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+
+  for(unsigned long long i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == 3,
+      std::format(
+        "Expected test {} to run once, but it has {} assertions",
+        i,
+        outcome.assertion_count()));
+  }
+
+  auto const &slow_outcome = results.test_outcome(slow_test);
+  auto const slow_pid = message_number(slow_outcome, 0);
+  auto const slow_start = message_number(slow_outcome, 1);
+  auto const slow_end = message_number(slow_outcome, 2);
+
+  // Tests queued behind the slow one are taken over by the other
+  // worker instead of waiting for it
+  for(unsigned long long i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    auto const start = message_number(outcome, 1);
+    REQUIRE_IN_MAIN(
+      i == slow_test || message_number(outcome, 0) != slow_pid ||
+        start < slow_start || start > slow_end,
+      std::format("Expected test {} to be taken over by the other worker", i));
+    REQUIRE_IN_MAIN(
+      i == slow_test || start < slow_end,
+      std::format("Expected test {} to start before the slow test ended", i));
+  }
+
+  return 0;
+}
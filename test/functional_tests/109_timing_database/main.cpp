@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned test_count = 6;
+
+// Registration order deliberately differs from duration order
+constexpr unsigned durations_ms[test_count] = {40, 100, 0, 60, 20, 80};
+
+auto now_ns() -> long long
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+auto start_ns(waypoint::TestOutcome const &outcome) -> long long
+{
+  return std::stoll(outcome.assertion_outcome(0).message());
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    auto const duration = std::chrono::milliseconds{durations_ms[i]};
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [duration](waypoint::Context const &ctx)
+        {
+          ctx.assert(true, std::to_string(now_ns()).c_str());
+          std::this_thread::sleep_for(duration);
+        })
+      .timeout_ms(5'000);
+  }
+}
+
+auto main() -> int
+{
+  auto const path = std::filesystem::temp_directory_path() /
+    std::format("waypoint_timing_database_{}", ::getpid());
+  auto const lock_path = std::filesystem::path{path.string() + ".lock"};
+
+  waypoint::RunConfig config;
+  config.workers(1).timing_database(path.c_str());
+
+  {
+    auto const t = waypoint::TestRun::create();
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(results.success(), "Expected the first run to succeed");
+    REQUIRE_IN_MAIN(
+      std::filesystem::exists(path),
+      "Expected the first run to create the timing database");
+  }
+
+  auto const t = waypoint::TestRun::create();
+  auto const results = run_all_tests(t, config);
+
+  std::filesystem::remove(path);
+  std::filesystem::remove(lock_path);
+
+  REQUIRE_IN_MAIN(results.success(), "Expected the second run to succeed");
+
+  // The second run starts the tests longest first
+  for(unsigned long long i = 0; i < test_count; ++i)
+  {
+    for(unsigned long long j = 0; j < test_count; ++j)
+    {
+      REQUIRE_IN_MAIN(
+        durations_ms[i] <= durations_ms[j] ||
+          start_ns(results.test_outcome(i)) <
+            start_ns(results.test_outcome(j)),
+        std::format("Expected test {} to start before test {}", i, j));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <cstdlib>
+#include <format>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+constexpr unsigned long long test_count = 10;
+constexpr unsigned long long shard_count = 3;
+
+enum class ShardSource : unsigned char
+{
+  Config,
+  Environment
+};
+
+// Runs every shard and checks that together they run each test once
+auto check_shards(ShardSource const source) -> int
+{
+  std::set<std::string> test_names;
+  std::set<unsigned long long> test_indices;
+
+  for(unsigned long long shard = 0; shard < shard_count; ++shard)
+  {
+    if(source == ShardSource::Environment)
+    {
+      // Workers inherit the variables and select the same shard
+      ::setenv("WAYPOINT_SHARD_INDEX", std::to_string(shard).c_str(), 1);
+      ::setenv(
+        "WAYPOINT_SHARD_COUNT",
+        std::to_string(shard_count).c_str(),
+        1);
+    }
+
+    auto const t = waypoint::TestRun::create();
+
+    waypoint::RunConfig config;
+    if(source == ShardSource::Config)
+    {
+      config.shard(shard, shard_count);
+    }
+
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(
+      results.success(),
+      std::format("Expected shard {} to succeed", shard));
+    REQUIRE_IN_MAIN(
+      results.test_count() >= test_count / shard_count &&
+        results.test_count() <= test_count / shard_count + 1,
+      std::format(
+        "Expected shard {} to get its share of tests, but it has {}",
+        shard,
+        results.test_count()));
+
+    for(unsigned long long i = 0; i < results.test_count(); ++i)
+    {
+      auto const &outcome = results.test_outcome(i);
+      REQUIRE_IN_MAIN(
+        outcome.status() == waypoint::TestOutcome::Status::Success,
+        std::format("Expected {} to run", outcome.test_name()));
+      REQUIRE_IN_MAIN(
+        test_names.insert(outcome.test_name()).second,
+        std::format(
+          "Expected {} to be in only one shard",
+          outcome.test_name()));
+      REQUIRE_IN_MAIN(
+        test_indices.insert(outcome.test_index()).second,
+        std::format("Expected index {} to be unique", outcome.test_index()));
+    }
+  }
+
+  ::unsetenv("WAYPOINT_SHARD_INDEX");
+  ::unsetenv("WAYPOINT_SHARD_COUNT");
+
+  // The reports of all shards together cover the whole suite
+  REQUIRE_IN_MAIN(
+    test_names.size() == test_count,
+    std::format("Expected {} tests in total", test_count));
+  REQUIRE_IN_MAIN(
+    test_indices.size() == test_count &&
+      *test_indices.rbegin() == test_count - 1,
+    "Expected the test indices of all shards to be 0...N-1");
+
+  return 0;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned long long i = 0; i < test_count; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [](waypoint::Context const &ctx)
+        {
+          ctx.assert(true);
+        });
+  }
+}
+
+auto main() -> int
+{
+  if(
+    check_shards(ShardSource::Config) != 0 ||
+    check_shards(ShardSource::Environment) != 0)
+  {
+    return 1;
+  }
+
+  {
+    ::setenv("WAYPOINT_SHARD_INDEX", "1", 1);
+    ::setenv("WAYPOINT_SHARD_COUNT", "3 shards", 1);
+
+    auto const t = waypoint::TestRun::create();
+
+    waypoint::RunConfig config;
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(
+      !results.success(),
+      "Expected a malformed shard variable to fail the run");
+    REQUIRE_IN_MAIN(
+      results.error_count() == 1,
+      "Expected a malformed shard variable to be reported");
+    REQUIRE_STRING_EQUAL_IN_MAIN(
+      results.error(0),
+      "Shard variable WAYPOINT_SHARD_COUNT=3 shards is not a number",
+      "Unexpected error message");
+
+    // A shard set in the config takes precedence over the variables
+    auto const overridden_t = waypoint::TestRun::create();
+
+    waypoint::RunConfig overridden_config;
+    overridden_config.shard(0, 1);
+    auto const overridden_results =
+      run_all_tests(overridden_t, overridden_config);
+
+    REQUIRE_IN_MAIN(
+      overridden_results.success() &&
+        overridden_results.test_count() == test_count,
+      "Expected a shard set in the config to override the variables");
+
+    ::unsetenv("WAYPOINT_SHARD_INDEX");
+    ::unsetenv("WAYPOINT_SHARD_COUNT");
+  }
+
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.shard(shard_count, shard_count);
+
+  auto const results = run_all_tests(t, config);
+
+  REQUIRE_IN_MAIN(
+    !results.success(),
+    "Expected a shard index out of range to fail the run");
+  REQUIRE_IN_MAIN(
+    results.error_count() == 1,
+    "Expected a shard index out of range to be reported");
+  REQUIRE_STRING_EQUAL_IN_MAIN(
+    results.error(0),
+    "Shard index 3 is out of range for 3 shards",
+    "Unexpected error message");
+
+  return 0;
+}
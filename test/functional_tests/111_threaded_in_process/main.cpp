@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+constexpr unsigned test_count = 16;
+constexpr unsigned thread_unsafe_test_count = 3;
+constexpr unsigned thread_count = 4;
+
+std::atomic<unsigned> running_tests{0};
+std::atomic<unsigned> max_running_tests{0};
+
+void counted_body(waypoint::Context const &ctx, unsigned const i)
+{
+  auto const running = running_tests.fetch_add(1) + 1;
+  auto max_running = max_running_tests.load();
+  while(running > max_running &&
+        !max_running_tests.compare_exchange_weak(max_running, running))
+  {
+  }
+
+  ctx.assert(true, std::format("Test {} start", i).c_str());
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  ctx.assert(i % 2 == 0, std::format("Test {} end", i).c_str());
+
+  running_tests.fetch_sub(1);
+}
+
+void thread_unsafe_body(waypoint::Context const &ctx)
+{
+  ctx.assert(running_tests.fetch_add(1) == 0, "Ran alone");
+  std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  running_tests.fetch_sub(1);
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [i](waypoint::Context const &ctx)
+        {
+          counted_body(ctx, i);
+        });
+  }
+
+  for(unsigned i = 0; i < thread_unsafe_test_count; ++i)
+  {
+    t.test(g1, std::format("Thread-unsafe test {}", i).c_str())
+      .run(thread_unsafe_body)
+      .thread_unsafe();
+  }
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(thread_count);
+
+  auto const results = run_all_tests_in_process(t, config);
+
+  REQUIRE_IN_MAIN(
+    results.test_count() == test_count + thread_unsafe_test_count,
+    "Expected all tests in the results");
+  REQUIRE_IN_MAIN(
+    max_running_tests.load() > 1,
+    "Expected tests to run concurrently");
+  REQUIRE_IN_MAIN(
+    max_running_tests.load() <= thread_count,
+    "Expected no more concurrent tests than threads");
+
+  for(unsigned long long i = 0; i < test_count; ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    auto const expected_status = i % 2 == 0
+      ? waypoint::TestOutcome::Status::Success
+      : waypoint::TestOutcome::Status::Failure;
+    REQUIRE_IN_MAIN(
+      outcome.status() == expected_status,
+      std::format("Unexpected status of test {}", i));
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == 2,
+      std::format("Expected test {} to have 2 assertions", i));
+    REQUIRE_STRING_EQUAL_IN_MAIN(
+      outcome.assertion_outcome(0).message(),
+      std::format("Test {} start", i).c_str(),
+      std::format("Unexpected first assertion of test {}", i));
+    REQUIRE_STRING_EQUAL_IN_MAIN(
+      outcome.assertion_outcome(1).message(),
+      std::format("Test {} end", i).c_str(),
+      std::format("Unexpected second assertion of test {}", i));
+  }
+
+  for(unsigned long long i = test_count;
+      i < test_count + thread_unsafe_test_count;
+      ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    REQUIRE_IN_MAIN(
+      outcome.status() == waypoint::TestOutcome::Status::Success,
+      std::format("Expected thread-unsafe test {} to run alone", i));
+  }
+
+  return 0;
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned test_count = 8;
+
+unsigned build_count = 0;
+
+auto marker_path(long long const pid) -> std::filesystem::path
+{
+  return std::filesystem::temp_directory_path() /
+    std::format("waypoint_group_fixture_{}", pid);
+}
+
+// Leaves a marker file named after its process when destroyed
+class Index
+{
+public:
+  ~Index()
+  {
+    if(this->is_owner_)
+    {
+      std::ofstream{marker_path(this->pid_)} << "torn down\n";
+    }
+  }
+
+  Index()
+    : pid_{::getpid()},
+      build_number_{++build_count},
+      is_owner_{true}
+  {
+    // Longer than the default test timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds{150});
+  }
+
+  Index(Index const &other) = delete;
+
+  Index(Index &&other) noexcept
+    : pid_{other.pid_},
+      build_number_{other.build_number_},
+      is_owner_{other.is_owner_}
+  {
+    other.is_owner_ = false;
+  }
+
+  auto operator=(Index const &other) -> Index & = delete;
+  auto operator=(Index &&other) noexcept -> Index & = delete;
+
+  [[nodiscard]]
+  auto pid() const -> long long
+  {
+    return this->pid_;
+  }
+
+  [[nodiscard]]
+  auto build_number() const -> unsigned
+  {
+    return this->build_number_;
+  }
+
+private:
+  long long pid_;
+  unsigned build_number_;
+  bool is_owner_;
+};
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+  auto const g2 = t.group("Test group 2");
+
+  auto const index = t.group_fixture(
+    g1,
+    []()
+    {
+      return Index{};
+    });
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str())
+      .run(
+        [index](waypoint::Context const &ctx)
+        {
+          ctx.assert(true, std::to_string(::getpid()).c_str());
+          ctx.assert(index.get().pid() == ::getpid(), "Built in this process");
+          ctx.assert(index.get().build_number() == 1, "Built once");
+        });
+
+    t.test(g2, std::format("Test {}", i).c_str())
+      .run(
+        [](waypoint::Context const &ctx)
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds{100});
+          ctx.assert(true);
+        })
+      .timeout_ms(5'000);
+  }
+}
+
+auto main() -> int
+{
+  {
+    auto const t = waypoint::TestRun::create();
+
+    waypoint::RunConfig config;
+    config.workers(2).pipeline_depth(1);
+
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+
+    // The tests of the group stay with the worker which built its
+    // fixture, while the other worker runs the other group
+    auto const &first_outcome = results.test_outcome(0);
+    auto const pid = std::string{first_outcome.assertion_outcome(0).message()};
+    for(unsigned long long i = 0; i < results.test_count(); ++i)
+    {
+      auto const &outcome = results.test_outcome(i);
+      if(std::string{outcome.group_name()} == "Test group 1")
+      {
+        REQUIRE_IN_MAIN(
+          pid == outcome.assertion_outcome(0).message(),
+          std::format("Expected {} to run on the same worker", i));
+      }
+    }
+
+    auto const marker = marker_path(std::stoll(pid));
+    REQUIRE_IN_MAIN(
+      std::filesystem::exists(marker),
+      "Expected the worker to tear down the fixture");
+    std::filesystem::remove(marker);
+  }
+
+  auto const t = waypoint::TestRun::create();
+  auto const results = run_all_tests_in_process(t);
+
+  REQUIRE_IN_MAIN(
+    results.success(),
+    "Expected the in-process run to succeed");
+
+  auto const marker = marker_path(::getpid());
+  REQUIRE_IN_MAIN(
+    std::filesystem::exists(marker),
+    "Expected the in-process run to tear down the fixture");
+  std::filesystem::remove(marker);
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <format>
+#include <thread>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned test_count = 4;
+
+unsigned build_count = 0;
+bool is_in_process_run = false;
+
+struct State
+{
+  State()
+    : builder_pid{::getpid()},
+      build_number{++build_count},
+      value{0}
+  {
+    // Longer than the default test timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds{150});
+  }
+
+  long long builder_pid;
+  unsigned build_number;
+  int value;
+};
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Test group");
+
+  auto const state = t.snapshot_fixture(
+    g,
+    []()
+    {
+      return State{};
+    });
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g, std::format("Test {}", i).c_str())
+      .run(
+        [state](waypoint::Context const &ctx)
+        {
+          auto &value = state.get();
+          ctx.assert(value.value == 0, "Starts from the built value");
+          value.value += 1;
+
+          if(is_in_process_run)
+          {
+            ctx.assert(value.builder_pid == ::getpid(), "Rebuilt here");
+          }
+          else
+          {
+            ctx.assert(value.builder_pid == ::getppid(), "Built by worker");
+            ctx.assert(value.build_number == 1, "Built once");
+          }
+        });
+  }
+}
+
+auto main() -> int
+{
+  {
+    auto const t = waypoint::TestRun::create();
+
+    waypoint::RunConfig config;
+    config.workers(1);
+
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+  }
+
+  is_in_process_run = true;
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(2);
+
+  auto const results = run_all_tests_in_process(t, config);
+
+  REQUIRE_IN_MAIN(
+    results.success(),
+    "Expected the in-process run to succeed");
+  REQUIRE_IN_MAIN(
+    build_count == test_count,
+    "Expected the fixture to be rebuilt for each test");
+
+  return 0;
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <array>
+#include <cstring>
+#include <format>
+#include <string>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned test_count = 8;
+constexpr unsigned table_size = 65'536;
+// 32 MiB, more than fits on the stack
+constexpr unsigned large_table_size = 8 * 1'024 * 1'024;
+
+unsigned build_count = 0;
+bool is_in_process_run = false;
+
+struct Table
+{
+  long long builder_pid;
+  std::array<unsigned, table_size> squares;
+};
+
+auto build_table() -> Table
+{
+  ++build_count;
+
+  Table table{::getpid(), {}};
+  for(unsigned i = 0; i < table_size; ++i)
+  {
+    table.squares[i] = i * i;
+  }
+
+  return table;
+}
+
+struct LargeTable
+{
+  std::array<unsigned, large_table_size> values;
+};
+
+auto build_large_table() -> LargeTable
+{
+  LargeTable table;
+  for(unsigned i = 0; i < large_table_size; ++i)
+  {
+    table.values[i] = i;
+  }
+
+  return table;
+}
+
+// Its size is only known at run time
+auto make_corpus() -> std::string
+{
+  std::string corpus;
+  for(unsigned i = 0; i < 1'000; ++i)
+  {
+    corpus += std::format("Line {}\n", i);
+  }
+
+  return corpus;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Test group");
+
+  auto const table = t.shared_data(build_table);
+  auto const answer = t.shared_data(
+    []()
+    {
+      return 42;
+    });
+  auto const large_table = t.shared_data(build_large_table);
+  auto const corpus_text = make_corpus();
+  auto const corpus = t.shared_bytes(
+    corpus_text.size(),
+    [corpus_text](unsigned char *const destination)
+    {
+      std::memcpy(destination, corpus_text.data(), corpus_text.size());
+    });
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g, std::format("Test {}", i).c_str())
+      .run(
+        [table, answer, large_table, corpus, corpus_text, i](
+          waypoint::Context const &ctx)
+        {
+          auto const &value = table.get();
+          auto const n = i * 1'000;
+          ctx.assert(value.squares[n] == n * n, "Sees the built table");
+          ctx.assert(answer.get() == 42, "Sees every shared value");
+
+          auto const m = large_table_size - 1 - i;
+          ctx.assert(
+            large_table.get().values[m] == m,
+            "Sees a table larger than the stack");
+
+          ctx.assert(
+            corpus.size() == corpus_text.size(),
+            "Sees the size of the bytes");
+          ctx.assert(
+            std::memcmp(corpus.data(), corpus_text.data(), corpus.size()) == 0,
+            "Sees the bytes");
+
+          if(is_in_process_run)
+          {
+            ctx.assert(value.builder_pid == ::getpid(), "Built here");
+          }
+          else
+          {
+            ctx.assert(value.builder_pid != ::getpid(), "Built by parent");
+            ctx.assert(build_count == 0, "Never built by workers");
+          }
+        });
+  }
+}
+
+auto main() -> int
+{
+  {
+    auto const t = waypoint::TestRun::create();
+
+    waypoint::RunConfig config;
+    config.workers(2);
+
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+    REQUIRE_IN_MAIN(build_count == 1, "Expected the parent to build once");
+  }
+
+  is_in_process_run = true;
+  auto const t = waypoint::TestRun::create();
+  auto const results = run_all_tests_in_process(t);
+
+  REQUIRE_IN_MAIN(
+    results.success(),
+    "Expected the in-process run to succeed");
+  REQUIRE_IN_MAIN(build_count == 2, "Expected the in-process run to build");
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned in_process_test_count = 5;
+
+bool is_in_process_run = false;
+
+// Where the isolated test's process leaves its pid
+char const *const pid_path_env_name = "WAYPOINT_TEST_ISOLATED_PID_PATH";
+
+auto is_process_gone(long long const pid) -> bool
+{
+  if(::kill(static_cast<::pid_t>(pid), 0) != 0)
+  {
+    return errno == ESRCH;
+  }
+
+  // Orphans are reaped by whichever process adopts them, which may
+  // leave a zombie around for a while
+  std::ifstream stat{std::format("/proc/{}/stat", pid)};
+  std::string pid_field;
+  std::string name_field;
+  std::string state;
+  stat >> pid_field >> name_field >> state;
+
+  return state == "Z";
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Test group");
+
+  if(is_in_process_run)
+  {
+    for(unsigned i = 0; i < in_process_test_count; ++i)
+    {
+      t.test(g, std::format("Failing {}", i).c_str())
+        .run(
+          [](waypoint::Context const &ctx)
+          {
+            ctx.assert(false);
+          });
+    }
+
+    return;
+  }
+
+  t.test(g, "Failing")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds{300});
+        ctx.assert(false);
+      })
+    .timeout_ms(10'000);
+
+  t.test(g, "Blocking")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds{3'000});
+        ctx.assert(true);
+      })
+    .timeout_ms(10'000);
+
+  t.test(g, "Blocking isolated")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        {
+          std::ofstream pid_file{std::getenv(pid_path_env_name)};
+          pid_file << ::getpid();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{3'000});
+        ctx.assert(true);
+      })
+    .isolated()
+    .timeout_ms(10'000);
+}
+
+auto main() -> int
+{
+  {
+    // Workers run main too, and keep the path of the process which
+    // spawned them
+    ::setenv(
+      pid_path_env_name,
+      (std::filesystem::temp_directory_path() /
+       std::format("waypoint_max_failures_{}", ::getpid()))
+        .c_str(),
+      0);
+    std::filesystem::path const pid_path{std::getenv(pid_path_env_name)};
+
+    auto const t = waypoint::TestRun::create();
+
+    waypoint::RunConfig config;
+    config.workers(3).pipeline_depth(1).max_failures(1);
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const results = run_all_tests(t, config);
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+    REQUIRE_IN_MAIN(
+      results.test_outcome(0).status() ==
+        waypoint::TestOutcome::Status::Failure,
+      "Expected the failing test to fail");
+    REQUIRE_IN_MAIN(
+      results.test_outcome(1).status() == waypoint::TestOutcome::Status::NotRun,
+      std::format(
+        "Expected the running test to be cancelled, got {}",
+        results.test_outcome(1).status()));
+    REQUIRE_IN_MAIN(
+      results.test_outcome(2).status() == waypoint::TestOutcome::Status::NotRun,
+      std::format(
+        "Expected the running isolated test to be cancelled, got {}",
+        results.test_outcome(2).status()));
+    REQUIRE_IN_MAIN(
+      elapsed < std::chrono::milliseconds{2'000},
+      "Expected the run to stop without waiting for the running tests");
+
+    long long isolated_pid = 0;
+    std::ifstream{pid_path} >> isolated_pid;
+    std::filesystem::remove(pid_path);
+    REQUIRE_IN_MAIN(isolated_pid > 0, "Expected the isolated test to start");
+
+    // The kill reaches the isolated test's process once its worker dies
+    auto const deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds{1'000};
+    while(
+      !is_process_gone(isolated_pid) &&
+      std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    REQUIRE_IN_MAIN(
+      is_process_gone(isolated_pid),
+      "Expected the isolated test's process to be killed");
+  }
+
+  is_in_process_run = true;
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.max_failures(2);
+
+  auto const results = run_all_tests_in_process(t, config);
+
+  unsigned failure_count = 0;
+  unsigned not_run_count = 0;
+  for(unsigned long long i = 0; i < results.test_count(); ++i)
+  {
+    auto const status = results.test_outcome(i).status();
+    failure_count += status == waypoint::TestOutcome::Status::Failure ? 1 : 0;
+    not_run_count += status == waypoint::TestOutcome::Status::NotRun ? 1 : 0;
+  }
+
+  REQUIRE_IN_MAIN(
+    failure_count == 2,
+    std::format("Expected 2 tests to fail, got {}", failure_count));
+  REQUIRE_IN_MAIN(
+    not_run_count == in_process_test_count - 2,
+    std::format("Expected the rest not to run, got {}", not_run_count));
+
+  return 0;
+}
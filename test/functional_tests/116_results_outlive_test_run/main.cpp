@@ -0,0 +1,75 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <format>
+#include <string>
+
+namespace
+{
+
+constexpr unsigned group_count = 3;
+constexpr unsigned tests_per_group = 4;
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  for(unsigned i = 0; i < group_count; ++i)
+  {
+    auto const g = t.group(std::format("Test group {}", i).c_str());
+
+    // The same test names in every group
+    for(unsigned j = 0; j < tests_per_group; ++j)
+    {
+      t.test(g, std::format("Test {}", j).c_str())
+        .run(
+          [](waypoint::Context const &ctx)
+          {
+            ctx.assert(false, "Failing assertion");
+          });
+    }
+  }
+}
+
+auto main() -> int
+{
+  // Names stay valid after the test run is gone
+  auto const results = run_all_tests_in_process(waypoint::TestRun::create());
+
+  REQUIRE_IN_MAIN(
+    results.test_count() == group_count * tests_per_group,
+    "Expected all tests to be reported");
+
+  for(unsigned i = 0; i < group_count; ++i)
+  {
+    for(unsigned j = 0; j < tests_per_group; ++j)
+    {
+      auto const &outcome = results.test_outcome(i * tests_per_group + j);
+      auto const group_name = std::format("Test group {}", i);
+      auto const test_name = std::format("Test {}", j);
+
+      REQUIRE_STRING_EQUAL_IN_MAIN(
+        outcome.group_name(),
+        group_name.c_str(),
+        "Expected the group name to be kept");
+      REQUIRE_STRING_EQUAL_IN_MAIN(
+        outcome.test_name(),
+        test_name.c_str(),
+        "Expected the test name to be kept");
+      REQUIRE_STRING_EQUAL_IN_MAIN(
+        outcome.assertion_outcome(0).group(),
+        group_name.c_str(),
+        "Expected the assertion to report its group");
+      REQUIRE_STRING_EQUAL_IN_MAIN(
+        outcome.assertion_outcome(0).test(),
+        test_name.c_str(),
+        "Expected the assertion to report its test");
+    }
+  }
+
+  return 0;
+}
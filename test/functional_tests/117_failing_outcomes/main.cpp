@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  t.test(g1, "Test 1")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(true, "Passing assertion 1");
+      });
+
+  t.test(g1, "Test 2")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(true, "Passing assertion 2");
+        ctx.assert(false, "Failing assertion 1");
+        ctx.assert(true, "Passing assertion 3");
+        ctx.assert(false, "Failing assertion 2");
+      });
+
+  t.test(g1, "Test 3")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(false, "Failing assertion 3");
+      })
+    .disable();
+
+  t.test(g1, "Test 4")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(false, "Failing assertion 4");
+      });
+}
+
+auto main() -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  auto const results = run_all_tests_in_process(t);
+
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+  REQUIRE_IN_MAIN(results.test_count() == 4, "Expected 4 tests");
+  REQUIRE_IN_MAIN(
+    results.failing_test_count() == 2,
+    "Expected only the enabled failing tests to be listed");
+
+  // Outcomes are built once and then shared by both accessors
+  REQUIRE_IN_MAIN(
+    &results.failing_test_outcome(0) == &results.test_outcome(1),
+    "Expected the first failing test to be Test 2");
+  REQUIRE_IN_MAIN(
+    &results.failing_test_outcome(1) == &results.test_outcome(3),
+    "Expected the second failing test to be Test 4");
+
+  auto const &outcome = results.failing_test_outcome(0);
+  REQUIRE_STRING_EQUAL_IN_MAIN(
+    outcome.test_name(),
+    "Test 2",
+    "Expected the failing test to report its name");
+  REQUIRE_IN_MAIN(
+    outcome.assertion_count() == 4,
+    "Expected all assertions to be reported");
+  REQUIRE_IN_MAIN(
+    outcome.failing_assertion_count() == 2,
+    "Expected 2 failing assertions");
+  REQUIRE_STRING_EQUAL_IN_MAIN(
+    outcome.failing_assertion_outcome(0).message(),
+    "Failing assertion 1",
+    "Expected failing assertions in index order");
+  REQUIRE_STRING_EQUAL_IN_MAIN(
+    outcome.failing_assertion_outcome(1).message(),
+    "Failing assertion 2",
+    "Expected failing assertions in index order");
+  REQUIRE_IN_MAIN(
+    &outcome.failing_assertion_outcome(1) == &outcome.assertion_outcome(3),
+    "Expected failing assertions to be views of all assertions");
+
+  REQUIRE_IN_MAIN(
+    results.test_outcome(0).failing_assertion_count() == 0,
+    "Expected a passing test to have no failing assertions");
+
+  return 0;
+}
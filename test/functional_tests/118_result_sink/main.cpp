@@ -0,0 +1,340 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <map>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+constexpr unsigned passing_assertion_count = 1'000;
+constexpr std::chrono::milliseconds slow_start_delay{200};
+constexpr unsigned blocking_test_count = 3;
+
+// Set for the run stopped by max_failures, whose workers inherit it
+char const *const stopped_run_env_name = "WAYPOINT_TEST_STOPPED_RUN";
+
+enum class Stage : unsigned char
+{
+  NotStarted,
+  Started,
+  Finished
+};
+
+class RecordingSink final : public waypoint::ResultSink
+{
+public:
+  void test_started(
+    char const *const /*group_name*/,
+    char const *const test_name,
+    unsigned long long const /*test_index*/) noexcept override
+  {
+    auto &stage = this->stages_[test_name];
+    this->is_ordered_ = this->is_ordered_ && stage == Stage::NotStarted;
+    stage = Stage::Started;
+    if(std::strcmp(test_name, "Slow start") == 0)
+    {
+      this->slow_start_started_at_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  void assertion(
+    char const *const /*group_name*/,
+    char const *const test_name,
+    unsigned long long const /*index*/,
+    bool const passed,
+    char const *const message) noexcept override
+  {
+    this->is_ordered_ =
+      this->is_ordered_ && this->stages_[test_name] == Stage::Started;
+    if(std::strcmp(test_name, "Slow start") == 0)
+    {
+      this->slow_start_asserted_at_ = std::chrono::steady_clock::now();
+    }
+    if(passed)
+    {
+      ++this->passed_count_;
+    }
+    else if(message != nullptr)
+    {
+      this->failure_message_ = message;
+    }
+  }
+
+  void test_finished(
+    char const *const /*group_name*/,
+    char const *const test_name,
+    waypoint::TestOutcome::Status const status) noexcept override
+  {
+    auto &stage = this->stages_[test_name];
+    this->is_ordered_ = this->is_ordered_ && stage == Stage::Started;
+    stage = Stage::Finished;
+    if(status == waypoint::TestOutcome::Status::Failure)
+    {
+      ++this->failed_test_count_;
+    }
+    if(status == waypoint::TestOutcome::Status::NotRun)
+    {
+      ++this->not_run_count_;
+    }
+  }
+
+  [[nodiscard]]
+  auto is_ordered() const -> bool
+  {
+    return this->is_ordered_;
+  }
+
+  [[nodiscard]]
+  auto finished_count() const -> unsigned long long
+  {
+    unsigned long long count = 0;
+    for(auto const &[name, stage] : this->stages_)
+    {
+      count += stage == Stage::Finished ? 1 : 0;
+    }
+
+    return count;
+  }
+
+  [[nodiscard]]
+  auto unfinished_count() const -> unsigned long long
+  {
+    unsigned long long count = 0;
+    for(auto const &[name, stage] : this->stages_)
+    {
+      count += stage == Stage::Started ? 1 : 0;
+    }
+
+    return count;
+  }
+
+  // How long after the slow starting test was reported as started it
+  // made its first assertion
+  [[nodiscard]]
+  auto slow_start_lead() const -> std::chrono::steady_clock::duration
+  {
+    return this->slow_start_asserted_at_ - this->slow_start_started_at_;
+  }
+
+  [[nodiscard]]
+  auto passed_count() const -> unsigned long long
+  {
+    return this->passed_count_;
+  }
+
+  [[nodiscard]]
+  auto failed_test_count() const -> unsigned long long
+  {
+    return this->failed_test_count_;
+  }
+
+  [[nodiscard]]
+  auto not_run_count() const -> unsigned long long
+  {
+    return this->not_run_count_;
+  }
+
+  [[nodiscard]]
+  auto failure_message() const -> std::string const &
+  {
+    return this->failure_message_;
+  }
+
+private:
+  std::map<std::string, Stage> stages_;
+  bool is_ordered_{true};
+  unsigned long long passed_count_{0};
+  unsigned long long failed_test_count_{0};
+  unsigned long long not_run_count_{0};
+  std::string failure_message_;
+  std::chrono::steady_clock::time_point slow_start_started_at_;
+  std::chrono::steady_clock::time_point slow_start_asserted_at_;
+};
+
+auto check_run(
+  waypoint::TestRunResult const &results,
+  RecordingSink const &sink) -> int
+{
+  REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+  REQUIRE_IN_MAIN(sink.is_ordered(), "Expected events in order");
+  REQUIRE_IN_MAIN(
+    sink.finished_count() == 4,
+    std::format("Expected 4 finished tests, got {}", sink.finished_count()));
+  REQUIRE_IN_MAIN(
+    sink.passed_count() == 2 * passing_assertion_count + 1,
+    std::format(
+      "Expected every passing assertion, got {}",
+      sink.passed_count()));
+  REQUIRE_IN_MAIN(sink.failed_test_count() == 1, "Expected 1 failed test");
+  REQUIRE_IN_MAIN(
+    sink.failure_message() == "Failing assertion",
+    "Expected the failing assertion's message");
+
+  // Only failures are kept, passing assertions are counted
+  auto const &passing = results.test_outcome(0);
+  REQUIRE_IN_MAIN(
+    passing.assertion_count() == 0,
+    "Expected no passing assertions to be kept");
+  REQUIRE_IN_MAIN(
+    passing.passing_assertion_count() == passing_assertion_count,
+    "Expected passing assertions to be counted");
+
+  auto const &failing = results.test_outcome(1);
+  REQUIRE_IN_MAIN(
+    failing.assertion_count() == 1,
+    "Expected the failing assertion to be kept");
+  REQUIRE_STRING_EQUAL_IN_MAIN(
+    failing.assertion_outcome(0).message(),
+    "Failing assertion",
+    "Expected the failing assertion's message to be kept");
+  REQUIRE_IN_MAIN(
+    failing.assertion_outcome(0).index() == passing_assertion_count,
+    "Expected the failing assertion to keep its index");
+
+  // Started when it runs, not when its first assertion arrives
+  REQUIRE_IN_MAIN(
+    sink.slow_start_lead() >= slow_start_delay / 2,
+    std::format(
+      "Expected the slow test to be started before its assertion, got {} us",
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        sink.slow_start_lead())
+        .count()));
+
+  return 0;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Test group");
+
+  if(std::getenv(stopped_run_env_name) != nullptr)
+  {
+    t.test(g, "Failing")
+      .run(
+        [](waypoint::Context const &ctx)
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds{300});
+          ctx.assert(false);
+        })
+      .timeout_ms(10'000);
+
+    for(unsigned i = 0; i < blocking_test_count; ++i)
+    {
+      t.test(g, std::format("Blocking {}", i).c_str())
+        .run(
+          [](waypoint::Context const &ctx)
+          {
+            ctx.assert(true);
+            std::this_thread::sleep_for(std::chrono::milliseconds{3'000});
+          })
+        .timeout_ms(10'000);
+    }
+
+    return;
+  }
+
+  t.test(g, "Passing")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        for(unsigned i = 0; i < passing_assertion_count; ++i)
+        {
+          ctx.assert(true, "Passing assertion");
+        }
+      });
+
+  t.test(g, "Failing")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        for(unsigned i = 0; i < passing_assertion_count; ++i)
+        {
+          ctx.assert(true);
+        }
+        ctx.assert(false, "Failing assertion");
+      });
+
+  t.test(g, "Empty")
+    .run(
+      [](waypoint::Context const & /*ctx*/)
+      {
+      });
+
+  t.test(g, "Slow start")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        std::this_thread::sleep_for(slow_start_delay);
+        ctx.assert(true);
+      })
+    .timeout_ms(10'000);
+}
+
+auto main() -> int
+{
+  {
+    auto const t = waypoint::TestRun::create();
+    RecordingSink sink;
+
+    waypoint::RunConfig config;
+    config.workers(2).pipeline_depth(1).max_failures(0).result_sink(sink);
+
+    auto const results = run_all_tests(t, config);
+    if(check_run(results, sink) != 0)
+    {
+      return 1;
+    }
+  }
+
+  {
+    ::setenv(stopped_run_env_name, "1", 1);
+    auto const t = waypoint::TestRun::create();
+    RecordingSink sink;
+
+    // Every test starts on a worker of its own, and the blocking ones
+    // are cancelled once the failing one fails
+    waypoint::RunConfig config;
+    config.workers(1 + blocking_test_count)
+      .pipeline_depth(1)
+      .max_failures(1)
+      .result_sink(sink);
+
+    auto const results = run_all_tests(t, config);
+    ::unsetenv(stopped_run_env_name);
+
+    REQUIRE_IN_MAIN(!results.success(), "Expected the run to fail");
+    REQUIRE_IN_MAIN(sink.is_ordered(), "Expected events in order");
+    REQUIRE_IN_MAIN(
+      sink.unfinished_count() == 0,
+      std::format(
+        "Expected every started test to finish, {} did not",
+        sink.unfinished_count()));
+    REQUIRE_IN_MAIN(
+      sink.not_run_count() == blocking_test_count,
+      std::format(
+        "Expected the cancelled tests to finish as not run, got {}",
+        sink.not_run_count()));
+  }
+
+  auto const t = waypoint::TestRun::create();
+  RecordingSink sink;
+
+  waypoint::RunConfig config;
+  config.workers(2).max_failures(0).result_sink(sink);
+
+  auto const results = run_all_tests_in_process(t, config);
+
+  return check_run(results, sink);
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned worker_count = 3;
+constexpr unsigned pipeline_depth = 4;
+constexpr unsigned test_count = worker_count * pipeline_depth;
+
+// Workers are spawned one after another, each finishing its handshake
+// before the next starts, so the order in which they claim a slot is
+// their order in the runner. Replacements claim later slots.
+unsigned worker_slot = 0;
+unsigned tests_run_in_process = 0;
+
+auto slot_directory(long long const parent_pid) -> std::filesystem::path
+{
+  return std::filesystem::temp_directory_path() /
+    std::format("waypoint_repeated_work_stealing_{}", parent_pid);
+}
+
+void claim_worker_slot(std::filesystem::path const &directory)
+{
+  for(unsigned slot = 0;; ++slot)
+  {
+    if(std::filesystem::create_directory(directory / std::to_string(slot)))
+    {
+      worker_slot = slot;
+
+      return;
+    }
+  }
+}
+
+void sleep_ms(unsigned const duration_ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds{duration_ms});
+}
+
+// Worker 0 runs a slow first test while worker 2, done with its own
+// tests, steals the ones queued behind it. Worker 1 then crashes, and
+// the tests it had queued are requeued onto worker 0, whose revoked
+// commands are still unread. Worker 2 steals from worker 0 again.
+void body(waypoint::Context const &ctx)
+{
+  auto const is_first_test = tests_run_in_process++ == 0;
+
+  if(worker_slot == 0 && is_first_test)
+  {
+    sleep_ms(3'000);
+  }
+  else if(worker_slot == 1 && is_first_test)
+  {
+    sleep_ms(1'100);
+    std::abort();
+  }
+  else if(worker_slot == 2)
+  {
+    sleep_ms(200);
+  }
+
+  ctx.assert(true);
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g1 = t.group("Test group 1");
+
+  for(unsigned i = 0; i < test_count; ++i)
+  {
+    t.test(g1, std::format("Test {}", i).c_str()).run(body).timeout_ms(10'000);
+  }
+}
+
+auto main() -> int
+{
+  // Only workers find the directory of the process that spawned them
+  if(std::filesystem::exists(slot_directory(::getppid())))
+  {
+    claim_worker_slot(slot_directory(::getppid()));
+  }
+  else
+  {
+    std::filesystem::remove_all(slot_directory(::getpid()));
+    std::filesystem::create_directory(slot_directory(::getpid()));
+  }
+
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(worker_count)
+    .pipeline_depth(pipeline_depth)
+    .spawn(waypoint::RunConfig::Spawn::Exec)
+    .isolation(waypoint::RunConfig::Isolation::SharedChild)
+    .max_failures(0);
+
+  auto const results = run_all_tests(t, config);
+  std::filesystem::remove_all(slot_directory(::getpid()));
+
+  unsigned crashed_count = 0;
+  for(unsigned long long i = 0; i < results.test_count(); ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    if(outcome.status() == waypoint::TestOutcome::Status::Terminated)
+    {
+      ++crashed_count;
+      continue;
+    }
+
+    REQUIRE_IN_MAIN(
+      outcome.status() == waypoint::TestOutcome::Status::Success,
+      std::format("Expected test {} to pass, got {}", i, outcome.status()));
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == 1,
+      std::format(
+        "Expected test {} to run once, but it has {} assertions",
+        i,
+        outcome.assertion_count()));
+  }
+
+  REQUIRE_IN_MAIN(
+    crashed_count == 1,
+    std::format("Expected exactly 1 crash, got {}", crashed_count));
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <format>
+#include <optional>
+#include <thread>
+
+namespace
+{
+
+constexpr auto test_duration = std::chrono::milliseconds{1'500};
+constexpr auto expected_lead = std::chrono::milliseconds{1'000};
+
+class TimingSink final : public waypoint::ResultSink
+{
+public:
+  void assertion(
+    char const *const /*group_name*/,
+    char const *const /*test_name*/,
+    unsigned long long const index,
+    bool const /*passed*/,
+    char const *const /*message*/) noexcept override
+  {
+    ++this->assertion_count_;
+    if(index == 0)
+    {
+      this->first_assertion_time_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  void test_finished(
+    char const *const /*group_name*/,
+    char const *const /*test_name*/,
+    waypoint::TestOutcome::Status const /*status*/) noexcept override
+  {
+    this->finish_time_ = std::chrono::steady_clock::now();
+  }
+
+  [[nodiscard]]
+  auto assertion_count() const -> unsigned long long
+  {
+    return this->assertion_count_;
+  }
+
+  // How long before the end of the test its first assertion arrived
+  [[nodiscard]]
+  auto lead() const -> std::optional<std::chrono::milliseconds>
+  {
+    if(
+      !this->first_assertion_time_.has_value() ||
+      !this->finish_time_.has_value())
+    {
+      return std::nullopt;
+    }
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+      this->finish_time_.value() - this->first_assertion_time_.value());
+  }
+
+private:
+  unsigned long long assertion_count_{0};
+  std::optional<std::chrono::steady_clock::time_point> first_assertion_time_;
+  std::optional<std::chrono::steady_clock::time_point> finish_time_;
+};
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Test group");
+
+  t.test(g, "Asserts once, then runs for long")
+    .run(
+      [](waypoint::Context const &ctx)
+      {
+        ctx.assert(true, "Early");
+        std::this_thread::sleep_for(test_duration);
+        ctx.assert(true, "Late");
+      })
+    .timeout_ms(10'000);
+}
+
+auto main() -> int
+{
+  for(auto const transport :
+      {waypoint::RunConfig::Transport::Pipe,
+       waypoint::RunConfig::Transport::SharedMemory})
+  {
+    auto const t = waypoint::TestRun::create();
+
+    TimingSink sink;
+    waypoint::RunConfig config;
+    config.transport(transport).flush_interval_ms(50).result_sink(sink);
+
+    auto const results = run_all_tests(t, config);
+
+    REQUIRE_IN_MAIN(results.success(), "Expected the run to succeed");
+    REQUIRE_IN_MAIN(
+      results.test_outcome(0).passing_assertion_count() == 2,
+      std::format(
+        "Expected 2 passing assertions, but there are {}",
+        results.test_outcome(0).passing_assertion_count()));
+    REQUIRE_IN_MAIN(
+      sink.assertion_count() == 2,
+      std::format(
+        "Expected the sink to see 2 assertions, but it saw {}",
+        sink.assertion_count()));
+
+    auto const lead = sink.lead();
+    REQUIRE_IN_MAIN(
+      lead.has_value() && lead.value() >= expected_lead,
+      std::format(
+        "Expected the first assertion at least {} ms before the test ended",
+        expected_lead.count()));
+  }
+
+  return 0;
+}
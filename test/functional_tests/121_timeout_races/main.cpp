@@ -0,0 +1,110 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <thread>
+
+namespace
+{
+
+constexpr unsigned test_pair_count = 50;
+constexpr unsigned assertion_count = 100;
+constexpr unsigned long long edge_timeout_ms = 20;
+
+// Its assertions reach the parent before it completes, so they are
+// seen even if it is killed along with the test ahead of it
+void asserting_body(waypoint::Context const &ctx)
+{
+  for(unsigned i = 0; i < assertion_count; ++i)
+  {
+    ctx.assert(true);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds{5});
+}
+
+auto check_run(waypoint::RunConfig::Transport const transport) -> int
+{
+  auto const t = waypoint::TestRun::create();
+
+  // Queued tests start as soon as the one ahead of them completes, so
+  // a test killed just after it completed has a successor running
+  waypoint::RunConfig config;
+  config.workers(1)
+    .pipeline_depth(4)
+    .transport(transport)
+    .flush_interval_ms(1)
+    .max_failures(0);
+
+  auto const results = run_all_tests(t, config);
+
+  for(unsigned long long i = 0; i < results.test_count(); ++i)
+  {
+    auto const &outcome = results.test_outcome(i);
+    if(std::strncmp(outcome.test_name(), "Edge", 4) == 0)
+    {
+      auto const status = outcome.status();
+      REQUIRE_IN_MAIN(
+        status == waypoint::TestOutcome::Status::Success ||
+          status == waypoint::TestOutcome::Status::Timeout,
+        std::format("Expected {} to pass or time out", outcome.test_name()));
+
+      continue;
+    }
+
+    // A test run again after its worker was killed keeps only the
+    // assertions of its second run
+    REQUIRE_IN_MAIN(
+      outcome.status() == waypoint::TestOutcome::Status::Success,
+      std::format("Expected {} to pass", outcome.test_name()));
+    REQUIRE_IN_MAIN(
+      outcome.assertion_count() == assertion_count,
+      std::format(
+        "Expected {} to have {} assertions, got {}",
+        outcome.test_name(),
+        assertion_count,
+        outcome.assertion_count()));
+  }
+
+  return 0;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const g = t.group("Test group");
+
+  for(unsigned i = 0; i < test_pair_count; ++i)
+  {
+    // Each finishes at a slightly different point around its timeout,
+    // so that some finish just as the parent decides to kill them
+    auto const duration = std::chrono::microseconds{
+      edge_timeout_ms * 1'000 - 500 + i * 20};
+    t.test(g, std::format("Edge {}", i).c_str())
+      .run(
+        [duration](waypoint::Context const & /*ctx*/)
+        {
+          std::this_thread::sleep_for(duration);
+        })
+      .timeout_ms(edge_timeout_ms);
+    t.test(g, std::format("Asserting {}", i).c_str())
+      .run(asserting_body)
+      .timeout_ms(10'000);
+  }
+}
+
+auto main() -> int
+{
+  if(check_run(waypoint::RunConfig::Transport::Pipe) != 0)
+  {
+    return 1;
+  }
+
+  return check_run(waypoint::RunConfig::Transport::SharedMemory);
+}
@@ -0,0 +1,211 @@
+// Copyright (c) 2026 Wojciech Kałuża
+// SPDX-License-Identifier: MIT
+// For license details, see LICENSE file
+
+#include "test_helpers/test_helpers.hpp"
+#include "waypoint/waypoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <string>
+
+#include <spawn.h>
+#include <unistd.h>
+
+#include <sys/wait.h>
+
+extern char **environ;
+
+namespace
+{
+
+constexpr unsigned writer_count = 2;
+constexpr unsigned runs_per_writer = 10;
+constexpr unsigned tests_per_run = 4;
+constexpr unsigned unrecorded_test_count = 10;
+
+// Where the database is, kept by every process the test spawns
+char const *const path_env_name = "WAYPOINT_TEST_TIMING_DATABASE_PATH";
+
+// Select the writer and its run a process registers the tests of, and
+// are inherited by its workers
+char const *const writer_env_name = "WAYPOINT_TEST_TIMING_WRITER";
+char const *const run_env_name = "WAYPOINT_TEST_TIMING_RUN";
+
+auto now_ns() -> long long
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+auto start_ns(waypoint::TestOutcome const &outcome) -> long long
+{
+  return std::stoll(outcome.assertion_outcome(0).message());
+}
+
+void body_record_start(waypoint::Context const &ctx)
+{
+  ctx.assert(true, std::to_string(now_ns()).c_str());
+}
+
+// Every run records tests of its own, so an update lost to a concurrent
+// one is not made good by a later run
+void register_run_tests(
+  waypoint::TestRun const &t,
+  unsigned const writer,
+  unsigned const run)
+{
+  auto const g =
+    t.group(std::format("Writer {} run {}", writer, run).c_str());
+  for(unsigned i = 0; i < tests_per_run; ++i)
+  {
+    t.test(g, std::format("Test {}", i).c_str()).run(body_record_start);
+  }
+}
+
+auto spawn_writer(unsigned const writer) -> ::pid_t
+{
+  ::setenv(writer_env_name, std::to_string(writer).c_str(), 1);
+  char path[] = "/proc/self/exe";
+  char *const argv[] = {path, nullptr};
+  ::pid_t pid = -1;
+  auto const error =
+    ::posix_spawn(&pid, path, nullptr, nullptr, argv, environ);
+  ::unsetenv(writer_env_name);
+
+  return error == 0 ? pid : -1;
+}
+
+auto has_succeeded(::pid_t const pid) -> bool
+{
+  int status = 0;
+  if(::waitpid(pid, &status, 0) != pid)
+  {
+    return false;
+  }
+
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+WAYPOINT_AUTORUN(waypoint::TestRun const &t)
+{
+  auto const *const writer = std::getenv(writer_env_name);
+  if(writer != nullptr)
+  {
+    register_run_tests(
+      t,
+      std::stoul(writer),
+      std::stoul(std::getenv(run_env_name)));
+
+    return;
+  }
+
+  for(unsigned writer = 0; writer < writer_count; ++writer)
+  {
+    for(unsigned run = 0; run < runs_per_writer; ++run)
+    {
+      register_run_tests(t, writer, run);
+    }
+  }
+
+  auto const g = t.group("Unrecorded");
+  for(unsigned i = 0; i < unrecorded_test_count; ++i)
+  {
+    t.test(g, std::format("Test {}", i).c_str()).run(body_record_start);
+  }
+}
+
+auto main() -> int
+{
+  // Workers run main too, and only the first process spawns the writers
+  auto const is_first_process = std::getenv(path_env_name) == nullptr;
+  if(is_first_process)
+  {
+    ::setenv(
+      path_env_name,
+      (std::filesystem::temp_directory_path() /
+       std::format("waypoint_concurrent_timing_database_{}", ::getpid()))
+        .c_str(),
+      1);
+  }
+  std::filesystem::path const path{std::getenv(path_env_name)};
+  auto const lock_path = std::filesystem::path{path.string() + ".lock"};
+
+  // Each writer keeps updating the database while the other does
+  if(std::getenv(writer_env_name) != nullptr)
+  {
+    waypoint::RunConfig config;
+    config.workers(1).timing_database(path.c_str());
+
+    for(unsigned run = 0; run < runs_per_writer; ++run)
+    {
+      ::setenv(run_env_name, std::to_string(run).c_str(), 1);
+      auto const t = waypoint::TestRun::create();
+      auto const results = run_all_tests(t, config);
+      REQUIRE_IN_MAIN(
+        results.success(),
+        "Expected the writer's run to succeed");
+    }
+
+    return 0;
+  }
+
+  if(is_first_process)
+  {
+    ::pid_t writers[writer_count];
+    for(unsigned writer = 0; writer < writer_count; ++writer)
+    {
+      writers[writer] = spawn_writer(writer);
+      REQUIRE_IN_MAIN(
+        writers[writer] > 0,
+        std::format("Expected writer {} to be spawned", writer));
+    }
+    for(unsigned writer = 0; writer < writer_count; ++writer)
+    {
+      REQUIRE_IN_MAIN(
+        has_succeeded(writers[writer]),
+        std::format("Expected writer {} to succeed", writer));
+    }
+
+    REQUIRE_IN_MAIN(
+      std::filesystem::exists(path),
+      "Expected the writers to create the timing database");
+  }
+
+  auto const t = waypoint::TestRun::create();
+
+  waypoint::RunConfig config;
+  config.workers(1).timing_database(path.c_str());
+  auto const results = run_all_tests(t, config);
+
+  std::filesystem::remove(path);
+  std::filesystem::remove(lock_path);
+
+  REQUIRE_IN_MAIN(results.success(), "Expected the final run to succeed");
+
+  // Only tests with a duration the database could be read back for
+  // start before those never recorded
+  constexpr unsigned long long recorded_test_count =
+    writer_count * runs_per_writer * tests_per_run;
+  for(unsigned long long i = 0; i < recorded_test_count; ++i)
+  {
+    for(unsigned long long j = 0; j < unrecorded_test_count; ++j)
+    {
+      auto const unrecorded = recorded_test_count + j;
+      REQUIRE_IN_MAIN(
+        start_ns(results.test_outcome(i)) <
+          start_ns(results.test_outcome(unrecorded)),
+        std::format(
+          "Expected recorded test {} to start before unrecorded test {}",
+          i,
+          unrecorded));
+    }
+  }
+
+  return 0;
+}